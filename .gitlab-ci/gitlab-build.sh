@@ -11,7 +11,7 @@ function section()
 	echo -e "section_end:`date +%s`:${id}\r\e[0K"
 }
 
-section configure cmake -B build -DCMAKE_BUILD_TYPE=${BUILD_TYPE} .
+section configure cmake -B build -DCMAKE_BUILD_TYPE=${BUILD_TYPE} ${CMAKE_OPTIONS:-} .
 section build     cmake --build build -j
 section unittest  cmake --build build --target test -- ARGS="--verbose"
 section tests     "(cd build ; ctest)"
@@ -0,0 +1,103 @@
+#include <semver/range.hpp>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace
+{
+std::string alternatives(std::size_t n)
+{
+	std::string s;
+	for (std::size_t i = 0; i < n; ++i) {
+		if (i > 0)
+			s += " || ";
+		s += "1.0." + std::to_string(i);
+	}
+	return s;
+}
+
+std::string comparators(std::size_t n)
+{
+	std::string s;
+	for (std::size_t i = 0; i < n; ++i) {
+		if (i > 0)
+			s += ' ';
+		s += ">=1.0." + std::to_string(i);
+	}
+	return s;
+}
+
+std::string carets(std::size_t n)
+{
+	std::string s;
+	for (std::size_t i = 0; i < n; ++i) {
+		if (i > 0)
+			s += " || ";
+		s += "^" + std::to_string(i) + ".x";
+	}
+	return s;
+}
+
+std::string long_prerelease(std::size_t n)
+{
+	std::string s = ">=1.2.3-a";
+	for (std::size_t i = 0; i < n; ++i)
+		s += ".a";
+	return s;
+}
+
+std::string empty_alternatives(std::size_t n)
+{
+	std::string s = "1.2.3";
+	for (std::size_t i = 0; i < n; ++i)
+		s += "||";
+	return s;
+}
+
+void run(const std::string & name, const std::string & s, const semver::range_limits & limits)
+{
+	using clock = std::chrono::steady_clock;
+
+	const auto t0 = clock::now();
+	const auto r = semver::range(s, limits);
+	const auto t1 = clock::now();
+	r.satisfies(semver::semver(1, 0, 0));
+	const auto t2 = clock::now();
+
+	const auto ms = [](auto d) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(d).count() / 1000.0;
+	};
+
+	std::cout << name << ": length=" << s.size() << " ok=" << r.ok() << " parse=" << ms(t1 - t0)
+			  << "ms satisfies=" << ms(t2 - t1) << "ms\n";
+}
+}
+
+int main(int, char **)
+{
+	// clang-format off
+	const std::pair<const char *, std::function<std::string(std::size_t)>> inputs[] = {
+		{"alternatives",       alternatives},
+		{"comparators",        comparators},
+		{"carets",             carets},
+		{"long-prerelease",    long_prerelease},
+		{"empty-alternatives", empty_alternatives},
+	};
+	// clang-format on
+
+	semver::range_limits limits;
+	limits.max_length = 64 * 1024;
+	limits.max_clauses = 256;
+	limits.max_comparators = 256;
+
+	for (const auto n : {1000u, 10000u, 100000u}) {
+		for (const auto & [name, gen] : inputs) {
+			const auto s = gen(n);
+			run(std::string(name) + "/" + std::to_string(n), s, semver::range_limits {});
+			run(std::string(name) + "/" + std::to_string(n) + "/limited", s, limits);
+		}
+	}
+
+	return 0;
+}
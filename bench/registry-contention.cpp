@@ -0,0 +1,96 @@
+#include <semver/registry.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Throughput of readers querying `max_satisfying` while one writer publishes
+// versions, with `version_registry` and with a vector guarded by a mutex.
+namespace
+{
+using clock = std::chrono::steady_clock;
+
+constexpr auto duration = std::chrono::milliseconds(500);
+
+// The same operations on a vector guarded by a mutex, for comparison.
+class locked_versions final
+{
+public:
+	semver::semver max_satisfying(const semver::range & r) const
+	{
+		const std::lock_guard lock(mutex_);
+		return r.max_satisfying(versions_);
+	}
+
+	void publish(const semver::semver & v)
+	{
+		const std::lock_guard lock(mutex_);
+		versions_.push_back(v);
+	}
+
+private:
+	mutable std::mutex mutex_;
+	std::vector<semver::semver> versions_;
+};
+
+template <typename Read, typename Write>
+void run(const std::string & name, unsigned int readers, Read read, Write write)
+{
+	std::atomic<bool> done {false};
+	std::atomic<std::uint64_t> reads {0u};
+	std::uint64_t writes = 0u;
+
+	std::vector<std::thread> threads;
+	for (unsigned int i = 0u; i < readers; ++i) {
+		threads.emplace_back([&] {
+			std::uint64_t n = 0u;
+			while (!done.load(std::memory_order_relaxed)) {
+				read();
+				++n;
+			}
+			reads += n;
+		});
+	}
+
+	const auto start = clock::now();
+	while (clock::now() - start < duration) {
+		write(writes++);
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+	done = true;
+	for (auto & t : threads)
+		t.join();
+
+	const auto s = std::chrono::duration<double>(clock::now() - start).count();
+	std::cout << name << ": readers=" << readers << " reads/s=" << static_cast<double>(reads) / s
+			  << " writes/s=" << static_cast<double>(writes) / s << '\n';
+}
+}
+
+int main(int argc, char ** argv)
+{
+	const auto max_readers = (argc > 1) ? static_cast<unsigned int>(std::atoi(argv[1]))
+										: std::max(2u, std::thread::hardware_concurrency());
+	const auto r = semver::range("^1.0.0 <1.0.100");
+
+	for (unsigned int readers = 1u; readers <= max_readers; readers *= 2u) {
+		{
+			auto registry = semver::version_registry();
+			run(
+				"registry", readers, [&] { registry.snapshot().max_satisfying(r); },
+				[&](std::uint64_t i) { registry.publish(semver::semver(1, 0, i)); });
+		}
+		{
+			auto locked = locked_versions();
+			run(
+				"mutex", readers, [&] { locked.max_satisfying(r); },
+				[&](std::uint64_t i) { locked.publish(semver::semver(1, 0, i)); });
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef SEMVER_ALLOCATION_HPP
+#define SEMVER_ALLOCATION_HPP
+
+#include <cstddef>
+
+namespace semver
+{
+inline namespace v1
+{
+// Number of heap allocations and requested bytes.
+struct allocation_stats {
+	std::size_t count = 0u;
+	std::size_t bytes = 0u;
+};
+
+// Returns true if the library was built with `ENABLE_ALLOCATION_COUNTING`.
+// Otherwise all statistics are reported as zero.
+bool allocation_counting_enabled() noexcept;
+
+// Returns the allocations of the calling thread since the start of the thread.
+allocation_stats thread_allocations() noexcept;
+
+// Measures the allocations of the calling thread between construction
+// of the scope and the call of `stats()`. Scopes may be nested.
+//
+// Example:
+//
+//   const auto scope = allocation_scope();
+//   const auto v = semver("1.2.3");
+//   assert(scope.stats().count == 0u);
+//
+class allocation_scope final
+{
+public:
+	allocation_scope() noexcept
+		: start_(thread_allocations())
+	{
+	}
+
+	allocation_stats stats() const noexcept
+	{
+		const auto now = thread_allocations();
+		return {now.count - start_.count, now.bytes - start_.bytes};
+	}
+
+private:
+	allocation_stats start_;
+};
+
+// Returns the allocations made by the calling thread while executing `f`.
+template <typename Function> allocation_stats count_allocations(Function f)
+{
+	const auto scope = allocation_scope();
+	f();
+	return scope.stats();
+}
+}
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef SEMVER_BINARY_HPP
+#define SEMVER_BINARY_HPP
+
+#include <semver/range.hpp>
+#include <semver/semver.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace semver
+{
+inline namespace v1
+{
+// Compact binary encoding of versions and compiled ranges, e.g. for caches.
+//
+// A buffer starts with a header: the characters `SVB` followed by the format
+// version (one byte). Encoded versions and ranges follow, without padding.
+//
+//   version    : major, minor and patch as varint, followed by prerelease and build,
+//                each as varint length and the characters
+//   range      : number of alternatives as varint, for each alternative the number
+//                of comparators as varint, for each comparator the operator (one byte)
+//                and the version
+//
+// Varints are unsigned LEB128: 7 bits per byte, least significant group first,
+// the high bit is set on all but the last byte.
+//
+// Views read encoded data in place, without copying or allocating. Decoding checks
+// the structure of the data (lengths, varints, operators), but not the characters of
+// prereleases and build metadata, the data is expected to be written by `encode`.
+
+constexpr std::uint8_t binary_format_version = 1u;
+constexpr std::size_t binary_header_size = 4u;
+
+// Appends the header of a buffer.
+void encode_header(std::string & out);
+
+// Returns the format version of the buffer, 0 if it does not start with a header.
+std::uint8_t decode_header(std::string_view data) noexcept;
+
+// Appends the encoded version or range. Invalid versions and ranges can not be
+// encoded, nothing is appended and false is returned.
+bool encode(const semver & v, std::string & out);
+bool encode(const range & r, std::string & out);
+
+// Read-only view of an encoded version at the beginning of a buffer.
+class semver_view final
+{
+public:
+	semver_view() = default;
+	explicit semver_view(std::string_view data) noexcept;
+
+	bool ok() const noexcept { return good_; }
+	explicit operator bool() const noexcept { return ok(); }
+
+	// number of bytes of the encoded version
+	std::size_t size() const noexcept { return size_; }
+
+	semver::number_type major() const noexcept { return major_; }
+	semver::number_type minor() const noexcept { return minor_; }
+	semver::number_type patch() const noexcept { return patch_; }
+	std::string_view prerelease() const noexcept { return prerelease_; }
+	std::string_view build() const noexcept { return build_; }
+
+	semver to_semver() const;
+
+private:
+	semver::number_type major_ = {};
+	semver::number_type minor_ = {};
+	semver::number_type patch_ = {};
+	std::string_view prerelease_ = {};
+	std::string_view build_ = {};
+	std::size_t size_ = 0u;
+	bool good_ = false;
+};
+
+bool operator==(const semver_view & v1, const semver & v2) noexcept;
+bool operator<(const semver_view & v1, const semver & v2) noexcept;
+bool operator<(const semver & v1, const semver_view & v2) noexcept;
+bool operator==(const semver_view & v1, const semver_view & v2) noexcept;
+bool operator<(const semver_view & v1, const semver_view & v2) noexcept;
+
+// Read-only view of an encoded range at the beginning of a buffer.
+class range_view final
+{
+public:
+	range_view() = default;
+	explicit range_view(std::string_view data) noexcept;
+
+	bool ok() const noexcept { return good_; }
+	explicit operator bool() const noexcept { return ok(); }
+
+	// number of bytes of the encoded range
+	std::size_t size() const noexcept { return data_.size(); }
+
+	// Evaluates the range directly on the encoded data.
+	bool satisfies(const semver & v) const noexcept;
+
+	range to_range() const;
+
+private:
+	std::string_view data_ = {};
+	bool good_ = false;
+};
+}
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef SEMVER_CATALOG_HPP
+#define SEMVER_CATALOG_HPP
+
+#include <semver/binary.hpp>
+#include <semver/range.hpp>
+#include <semver/semver.hpp>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+// Read-only catalog of packages and their versions, queried in place, e.g. from
+// a memory mapped file. Nothing is deserialized, versions are read as `semver_view`.
+//
+// File layout, all integers are unsigned little endian:
+//
+//   header   : the characters `SVC`, the format version (one byte), 4 bytes reserved
+//              and the number of packages (64 bit)
+//   index    : one entry per package, sorted by name (bytewise): name offset, name
+//              size, block offset, block size and number of versions (64 bit each)
+//   names    : characters of all package names
+//   blocks   : one per package, the offsets of the versions relative to the end of
+//              the offsets (32 bit each), followed by the versions in the encoding
+//              of `semver/binary.hpp`, sorted by precedence
+//
+// Offsets of names and blocks are relative to the beginning of the file.
+
+constexpr std::uint8_t catalog_format_version = 1u;
+
+// Sorted versions of one package.
+class catalog_versions final
+{
+public:
+	catalog_versions() = default;
+	catalog_versions(std::string_view block, std::size_t count) noexcept;
+
+	std::size_t size() const noexcept { return count_; }
+	bool empty() const noexcept { return count_ == 0u; }
+
+	// Returns the version at index `i`, the view is invalid if the data is corrupt.
+	semver_view operator[](std::size_t i) const noexcept;
+
+	// Return the highest/lowest version satisfying the range, invalid views if
+	// none does. Versions outside of the bounds of the range are skipped using
+	// binary search.
+	semver_view max_satisfying(const range & r) const noexcept;
+	semver_view min_satisfying(const range & r) const noexcept;
+
+	// Returns all versions satisfying the range, in ascending order.
+	std::vector<semver_view> satisfying(const range & r) const;
+
+private:
+	std::string_view offsets_ = {};
+	std::string_view data_ = {};
+	std::size_t count_ = 0u;
+
+	// indices of the versions within the bounds of the range
+	std::pair<std::size_t, std::size_t> candidates(const range & r) const noexcept;
+};
+
+// View of a catalog, the data must outlive the catalog.
+class catalog final
+{
+public:
+	catalog() = default;
+	explicit catalog(std::string_view data) noexcept;
+
+	bool ok() const noexcept { return good_; }
+	explicit operator bool() const noexcept { return ok(); }
+
+	// number of packages
+	std::size_t size() const noexcept { return count_; }
+
+	std::string_view package(std::size_t i) const noexcept;
+
+	// Returns the versions of a package, empty if the package is unknown.
+	catalog_versions versions(std::string_view package) const noexcept;
+	catalog_versions versions(std::size_t i) const noexcept;
+
+private:
+	std::string_view data_ = {};
+	std::size_t count_ = 0u;
+	bool good_ = false;
+};
+
+// Catalog read from a file, memory mapped if the platform supports it.
+class catalog_file final
+{
+public:
+	explicit catalog_file(const std::string & path);
+	~catalog_file();
+
+	catalog_file(const catalog_file &) = delete;
+	catalog_file & operator=(const catalog_file &) = delete;
+
+	bool ok() const noexcept { return catalog_.ok(); }
+	explicit operator bool() const noexcept { return ok(); }
+
+	const catalog & get() const noexcept { return catalog_; }
+
+private:
+	std::string storage_;
+	const char * mapped_ = nullptr;
+	std::size_t size_ = 0u;
+	catalog catalog_;
+};
+
+// Collects packages and versions and creates the catalog data.
+class catalog_builder final
+{
+public:
+	// Adds a version of a package, invalid versions are ignored and false is returned.
+	bool add(std::string_view package, const semver & v);
+
+	// Returns the catalog data. Identical versions of a package are stored once.
+	// Returns an empty string if the catalog can not be represented, e.g. a block
+	// exceeding the 32 bit offsets.
+	std::string build() const;
+
+	// Writes the catalog data to a file.
+	bool write(const std::string & path) const;
+
+private:
+	std::map<std::string, std::vector<semver>, std::less<>> packages_;
+};
+}
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef SEMVER_COERCE_HPP
+#define SEMVER_COERCE_HPP
+
+#include <semver/semver.hpp>
+#include <string_view>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+struct coerce_options {
+	// includes prerelease and build metadata following the version,
+	// e.g. `1.2.3-rc.1+b7` instead of `1.2.3`.
+	bool include_prerelease = false;
+};
+
+// Version-like substring found by coercion. All views refer to the scanned text.
+struct coerce_match {
+	std::string_view text = {};
+	semver::number_type major = {};
+	semver::number_type minor = {};
+	semver::number_type patch = {};
+	std::string_view prerelease = {};
+	std::string_view build = {};
+
+	semver to_semver() const;
+};
+
+// Finds version-like substrings in arbitrary text, like `coerce` of node-semver:
+// one to three numbers of at most 16 digits each, separated by dots, not preceded
+// or followed by a digit. Missing minor and patch are 0. Examples:
+//
+//   `release-v1.2.3-final.tar.gz` : 1.2.3 (with prerelease: 1.2.3-final.tar.gz)
+//   `v2`                          : 2.0.0
+//   `1.2.3.4`                     : 1.2.3 and 4.0.0
+//
+// Numbers within a prerelease or build metadata are not matches on their own.
+// The text is scanned once, without copying, skipping text without digits by
+// words instead of characters.
+class coerce_scanner final
+{
+public:
+	explicit coerce_scanner(std::string_view text, const coerce_options & opt = {}) noexcept
+		: text_(text)
+		, opt_(opt)
+	{
+	}
+
+	// Finds the next match, returns false if there is none.
+	bool next(coerce_match & m) noexcept;
+
+private:
+	std::string_view text_;
+	coerce_options opt_;
+	std::size_t pos_ = 0u;
+};
+
+// Returns all matches within the text.
+std::vector<coerce_match> coerce_all(std::string_view text, const coerce_options & opt = {});
+
+// Returns the first match within the text as version, invalid if there is none.
+semver coerce(std::string_view text, const coerce_options & opt = {});
+}
+}
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef SEMVER_COMPRESSED_HPP
+#define SEMVER_COMPRESSED_HPP
+
+#include <semver/range.hpp>
+#include <semver/semver.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+// Sorted list of versions held compressed in memory, e.g. the histories of all
+// packages of a registry. Versions are decoded on the fly, one at a time.
+//
+// Versions are stored in blocks of `block_size`. The first version of a block is
+// encoded on its own, the others as difference to their predecessor: one byte for
+// the usual increment of the patch number. Prerelease identifiers and build metadata
+// are stored once in a dictionary shared by all versions of the list, numeric
+// identifiers are stored as numbers. The offsets of the blocks serve as skip pointers,
+// queries decode only the blocks which may contain satisfying versions.
+class compressed_versions final
+{
+public:
+	static constexpr std::size_t block_size = 64u;
+
+	class const_iterator final
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = semver;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const semver *;
+		using reference = const semver &;
+
+		const_iterator() = default;
+
+		reference operator*() const noexcept { return current_; }
+		pointer operator->() const noexcept { return &current_; }
+
+		const_iterator & operator++();
+		const_iterator operator++(int);
+
+		friend bool operator==(const const_iterator & a, const const_iterator & b) noexcept
+		{
+			return a.index_ == b.index_;
+		}
+		friend bool operator!=(const const_iterator & a, const const_iterator & b) noexcept
+		{
+			return !(a == b);
+		}
+
+	private:
+		friend class compressed_versions;
+
+		const compressed_versions * list_ = nullptr;
+		std::size_t index_ = 0u;
+		std::size_t offset_ = 0u; // of the next version
+		semver current_;
+
+		const_iterator(const compressed_versions * list, std::size_t index);
+	};
+
+	compressed_versions() = default;
+
+	// Compresses versions sorted in ascending order of precedence. The list is not
+	// ok if they are not sorted or contain invalid versions.
+	explicit compressed_versions(const std::vector<semver> & versions);
+
+	bool ok() const noexcept { return good_; }
+	explicit operator bool() const noexcept { return ok(); }
+
+	std::size_t size() const noexcept { return count_; }
+	bool empty() const noexcept { return count_ == 0u; }
+
+	// Returns the version at index `i`, decoding at most one block.
+	semver operator[](std::size_t i) const;
+
+	const_iterator begin() const { return const_iterator(this, 0u); }
+	const_iterator end() const { return const_iterator(this, count_); }
+
+	// Return the highest/lowest version satisfying the range, invalid versions if
+	// none does. Of versions with equal precedence the first one is returned, like
+	// `range::max_satisfying` does. Blocks outside of the bounds of the range are
+	// skipped using binary search on the first versions of the blocks.
+	semver max_satisfying(const range & r) const;
+	semver min_satisfying(const range & r) const;
+
+	// Returns the number of bytes allocated by the list, including the object itself.
+	std::size_t memory_usage() const noexcept;
+
+	// Returns the number of bytes a vector of the versions allocates, to compare
+	// with `memory_usage`.
+	static std::size_t memory_usage(const std::vector<semver> & versions) noexcept;
+
+private:
+	bool good_ = false;
+	std::size_t count_ = 0u;
+	std::string data_; // encoded versions
+	std::vector<std::uint32_t> blocks_; // offsets of the blocks within `data_`
+	std::string dictionary_; // characters of the dictionary entries
+	std::vector<std::uint32_t> entries_; // offsets of the entries, and the end of the last one
+
+	std::string_view entry(std::uint64_t i) const noexcept;
+
+	// Decodes the version at `offset` into `v`, advances `offset` past it. The version
+	// is relative to `v`, unless it is the first version of a block.
+	void decode(std::size_t & offset, semver & v, bool block_start) const;
+
+	semver block_start(std::size_t block) const;
+	std::size_t block_end(std::size_t block) const noexcept;
+
+	// the blocks which may contain versions satisfying the range
+	std::pair<std::size_t, std::size_t> candidates(const range & r) const;
+};
+}
+}
+
+#endif
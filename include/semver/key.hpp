@@ -0,0 +1,61 @@
+#ifndef SEMVER_KEY_HPP
+#define SEMVER_KEY_HPP
+
+#include <semver/range.hpp>
+#include <semver/semver.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+// Order preserving encoding of versions: comparing the keys of two versions bytewise
+// (`memcmp`, `std::string::compare`, ordered key value stores) yields the same order
+// as comparing the versions by precedence. Versions of equal precedence have equal
+// keys, build metadata is therefore not part of the key.
+//
+//   number     : number of significant bytes (one byte), followed by the bytes of
+//                the number, most significant first. 0 is encoded as 0x00.
+//   key        : major, minor and patch as number, followed by
+//                 - a release: 0x03
+//                 - a prerelease: its identifiers, followed by 0x00
+//   identifier : numeric: 0x01, the number of significant digits as number, the
+//                significant digits and the number of leading zeros as number.
+//                alphanumeric: 0x02, the characters, followed by 0x00.
+//
+// Numeric identifiers are ordered by their number of significant digits first, this
+// is the numeric order, independent of their size. Identifiers of the same number are
+// ordered by their leading zeros, e.g. `1 < 01 < 2`.
+// Keys are prefix free, no key is the beginning of another one.
+
+// Appends the key of the version, nothing is appended for invalid versions and
+// versions with more than 65535 leading zeros in a numeric identifier, false is
+// returned then.
+bool encode_key(const semver & v, std::string & out);
+
+// Returns the key of the version, an empty string if it is not encodable.
+std::string to_key(const semver & v);
+
+// Decodes the key at the beginning of `data`. Returns the number of bytes of the key,
+// 0 if `data` does not start with a valid key, `v` is not changed then.
+std::size_t decode_key(std::string_view data, semver & v);
+
+// Returns the version of a key, invalid if `key` is not exactly one valid key.
+semver from_key(std::string_view key);
+
+// Interval [start, end) of keys, an empty `end` means there is no upper end.
+struct key_interval {
+	std::string start;
+	std::string end;
+};
+
+// Returns the sorted, disjoint key intervals containing exactly the keys of the versions
+// satisfying the range, e.g. to seek to them in an ordered key value store instead of
+// checking all keys. Returns no intervals for invalid or unsatisfiable ranges.
+std::vector<key_interval> key_intervals(const range & r);
+}
+}
+
+#endif
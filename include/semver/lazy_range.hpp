@@ -0,0 +1,85 @@
+#ifndef SEMVER_LAZY_RANGE_HPP
+#define SEMVER_LAZY_RANGE_HPP
+
+#include <semver/range.hpp>
+#include <semver/semver.hpp>
+#include <atomic>
+#include <iosfwd>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+enum class range_check {
+	none, // only store the text
+	syntax, // check the syntax without compiling, no allocation
+};
+
+// Range stored as text, which is compiled on first use, e.g. ranges of manifests
+// of which most are never evaluated. Compiling happens once, also if the range is
+// used by several threads at the same time.
+//
+// The syntax check scans with the grammar of the parser, it recognizes exactly the
+// ranges which would fail to compile, `ok()` of such ranges does not compile them.
+class lazy_range final
+{
+public:
+	explicit lazy_range(std::string s, range_check check = range_check::none,
+		const range_limits & limits = {});
+
+	// Copies are compiled on their own first use, moves take the compiled range along.
+	lazy_range(const lazy_range & other);
+	lazy_range(lazy_range && other) noexcept;
+	lazy_range & operator=(const lazy_range &) = delete;
+	lazy_range & operator=(lazy_range &&) = delete;
+	~lazy_range() = default;
+
+	const std::string & text() const noexcept { return text_; }
+
+	// Returns true if the range was compiled already.
+	bool compiled() const noexcept { return compiled_.load(std::memory_order_acquire); }
+
+	// Returns the compiled range, compiles it if necessary.
+	const range & get() const;
+
+	bool ok() const;
+	explicit operator bool() const { return ok(); }
+
+	semver max() const { return get().max(); }
+	semver min() const { return get().min(); }
+
+	bool satisfies(const semver & v) const { return get().satisfies(v); }
+	bool outside(const semver & v) const { return get().outside(v); }
+	bool gtr(const semver & v) const { return get().gtr(v); }
+	bool ltr(const semver & v) const { return get().ltr(v); }
+
+	semver max_satisfying(const std::vector<semver> & versions) const
+	{
+		return get().max_satisfying(versions);
+	}
+
+	semver min_satisfying(const std::vector<semver> & versions) const
+	{
+		return get().min_satisfying(versions);
+	}
+
+private:
+	std::string text_;
+	range_limits limits_;
+	bool syntax_ok_ = true;
+
+	mutable std::once_flag once_;
+	mutable std::atomic<bool> compiled_ = false;
+	mutable std::optional<range> range_;
+};
+
+std::string to_string(const lazy_range & r);
+std::ostream & operator<<(std::ostream & os, const lazy_range & r);
+}
+}
+
+#endif
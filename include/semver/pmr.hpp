@@ -0,0 +1,190 @@
+#ifndef SEMVER_PMR_HPP
+#define SEMVER_PMR_HPP
+
+#include <semver/range.hpp>
+#include <semver/semver.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+// Variants of `semver` and `range` allocating all their memory from a
+// `std::pmr::memory_resource`, e.g. an arena dropped at once:
+//
+//   std::pmr::monotonic_buffer_resource arena;
+//   const auto r = pmr::range("^1.2.0 || ~2.0.0-rc.1", &arena);
+//   const auto v = pmr::semver("1.2.3-alpha.1", &arena);
+//   assert(r.satisfies(v));
+//
+// Like all allocator aware types of the standard library, copies get the
+// default resource unless a resource is passed explicitly.
+namespace pmr
+{
+class semver final
+{
+public:
+	using number_type = ::semver::semver::number_type;
+	using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+	semver() = default;
+	explicit semver(const allocator_type & alloc) noexcept;
+
+	semver(std::string_view s, const allocator_type & alloc = {});
+	semver(const std::string & s, const allocator_type & alloc = {})
+		: semver(std::string_view(s), alloc)
+	{
+	}
+	semver(const char * s, const allocator_type & alloc = {})
+		: semver(std::string_view(s), alloc)
+	{
+	}
+
+	// loose parsing needs a copy of the string, allocated from `alloc` as well
+	semver(std::string_view s, bool loose, const allocator_type & alloc);
+
+	semver(number_type major, number_type minor, number_type patch,
+		const allocator_type & alloc = {});
+	semver(number_type major, number_type minor, number_type patch,
+		std::string_view prerelease, std::string_view build = {},
+		const allocator_type & alloc = {});
+
+	explicit semver(const ::semver::semver & v, const allocator_type & alloc = {});
+
+	semver(const semver &) = default;
+	semver(const semver & other, const allocator_type & alloc);
+	semver(semver &&) noexcept = default;
+	semver(semver && other, const allocator_type & alloc);
+	semver & operator=(const semver &) = default;
+	semver & operator=(semver &&) = default;
+	~semver() = default;
+
+	number_type major() const noexcept { return major_; }
+	number_type minor() const noexcept { return minor_; }
+	number_type patch() const noexcept { return patch_; }
+	std::string_view build() const noexcept { return build_; }
+	std::string_view prerelease() const noexcept { return prerelease_; }
+
+	bool ok() const noexcept { return good_; }
+	explicit operator bool() const noexcept { return ok(); }
+
+	std::pmr::string str() const;
+	::semver::semver to_semver() const;
+
+	allocator_type get_allocator() const noexcept { return prerelease_.get_allocator(); }
+
+private:
+	number_type major_ = {};
+	number_type minor_ = {};
+	number_type patch_ = {};
+	std::pmr::string prerelease_ = {};
+	std::pmr::string build_ = {};
+
+	bool good_ = false;
+};
+
+std::ostream & operator<<(std::ostream & os, const semver & v);
+std::size_t formatted_size(const semver & v) noexcept;
+
+template <typename OutputIt> OutputIt format_to(OutputIt out, const semver & v)
+{
+	::semver::detail::format_semver(v, [&out](const char * s, std::size_t n) {
+		out = std::copy(s, s + n, out);
+	});
+	return out;
+}
+
+bool operator==(const semver & v1, const semver & v2) noexcept;
+bool operator!=(const semver & v1, const semver & v2) noexcept;
+bool operator<(const semver & v1, const semver & v2) noexcept;
+bool operator<=(const semver & v1, const semver & v2) noexcept;
+bool operator>(const semver & v1, const semver & v2) noexcept;
+bool operator>=(const semver & v1, const semver & v2) noexcept;
+int compare(const semver & v1, const semver & v2) noexcept;
+
+// Range stored as flat list of comparators, their prereleases are kept in one
+// string, all of them allocated from the memory resource.
+class range final
+{
+public:
+	using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+	range() = default;
+	explicit range(const allocator_type & alloc) noexcept;
+
+	// The text is parsed directly into the comparators, with the same result as
+	// `::semver::range`. Temporary memory of the parser is allocated from the
+	// resource as well, nothing is allocated from the heap.
+	range(std::string_view s, const allocator_type & alloc = {});
+	range(const std::string & s, const allocator_type & alloc = {})
+		: range(std::string_view(s), alloc)
+	{
+	}
+	range(const char * s, const allocator_type & alloc = {})
+		: range(std::string_view(s), alloc)
+	{
+	}
+	range(std::string_view s, const range_limits & limits, const allocator_type & alloc = {});
+
+	explicit range(const ::semver::range & r, const allocator_type & alloc = {});
+
+	range(const range &) = default;
+	range(const range & other, const allocator_type & alloc);
+	range(range &&) noexcept = default;
+	range(range && other, const allocator_type & alloc);
+	range & operator=(const range &) = default;
+	range & operator=(range &&) = default;
+	~range() = default;
+
+	bool ok() const noexcept { return good_; }
+	explicit operator bool() const noexcept { return ok(); }
+
+	bool satisfies(const semver & v) const noexcept;
+	bool satisfies(const ::semver::semver & v) const noexcept;
+
+	::semver::range to_range() const;
+
+	allocator_type get_allocator() const noexcept { return comparators_.get_allocator(); }
+
+	friend std::ostream & operator<<(std::ostream & os, const range & r);
+	friend std::string to_string(const range & r);
+	friend bool operator==(const range & r1, const range & r2) noexcept;
+
+private:
+	using number_type = semver::number_type;
+
+	enum class op : std::uint8_t { eq, lt, le, gt, ge };
+
+	struct comparator {
+		op type = op::eq;
+		number_type major = {};
+		number_type minor = {};
+		number_type patch = {};
+		std::uint32_t prerelease_offset = 0u;
+		std::uint32_t prerelease_size = 0u;
+	};
+
+	bool good_ = false;
+	std::pmr::vector<comparator> comparators_ = {};
+	std::pmr::vector<std::uint32_t> clause_ends_ = {}; // end of each alternative
+	std::pmr::string prereleases_ = {};
+
+	void assign(const std::vector<std::unique_ptr<detail::node>> & nodes);
+	template <typename V> bool eval(const V & v) const noexcept;
+	template <typename Write> void format(Write && write) const;
+};
+
+std::string to_string(const range & r);
+bool operator!=(const range & r1, const range & r2) noexcept;
+}
+}
+}
+
+#endif
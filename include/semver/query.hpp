@@ -0,0 +1,173 @@
+#ifndef SEMVER_QUERY_HPP
+#define SEMVER_QUERY_HPP
+
+#include <semver/range.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+// Release lines versions are grouped by.
+enum class release_line {
+	major, // e.g. 1.x.x
+	minor, // e.g. 1.2.x
+};
+
+namespace detail
+{
+// Refers to a version of a sequence while it is queried. Elements of forward
+// iterators are referred to by their iterator, those of input iterators are copied
+// because they are gone after advancing.
+template <typename Iterator, bool Forward = std::is_base_of_v<std::forward_iterator_tag,
+								 typename std::iterator_traits<Iterator>::iterator_category>>
+class query_entry final
+{
+public:
+	explicit query_entry(Iterator it, std::size_t index)
+		: it_(it)
+		, index_(index)
+	{
+	}
+
+	decltype(auto) get() const { return *it_; }
+	std::size_t index() const noexcept { return index_; }
+
+private:
+	Iterator it_;
+	std::size_t index_;
+};
+
+template <typename Iterator> class query_entry<Iterator, false> final
+{
+public:
+	explicit query_entry(Iterator it, std::size_t index)
+		: value_(*it)
+		, index_(index)
+	{
+	}
+
+	const typename std::iterator_traits<Iterator>::value_type & get() const noexcept
+	{
+		return value_;
+	}
+	std::size_t index() const noexcept { return index_; }
+
+private:
+	typename std::iterator_traits<Iterator>::value_type value_;
+	std::size_t index_;
+};
+
+// Returns true if `a` is to be preferred over `b`: the higher version, the earlier
+// one of equal precedence.
+template <typename Entry> bool query_prefer(const Entry & a, const Entry & b)
+{
+	if (b.get() < a.get())
+		return true;
+	if (a.get() < b.get())
+		return false;
+	return a.index() < b.index();
+}
+}
+
+// Returns the `k` highest versions of a sequence satisfying the range, the highest
+// first. Of versions with equal precedence the ones earlier in the sequence are
+// preferred, like `range::max_satisfying` does.
+//
+// The sequence is traversed once, keeping the best `k` versions in a bounded heap.
+// Elements of forward iterators are referred to, not copied, until the result is built.
+template <typename InputIt>
+std::vector<typename std::iterator_traits<InputIt>::value_type> top_satisfying(
+	const range & r, InputIt first, InputIt last, std::size_t k)
+{
+	using entry = detail::query_entry<InputIt>;
+
+	std::vector<typename std::iterator_traits<InputIt>::value_type> result;
+	if (k == 0u)
+		return result;
+
+	// heap of the best entries so far, the worst one on top
+	const auto better = [](const entry & a, const entry & b) { return detail::query_prefer(a, b); };
+	std::vector<entry> heap;
+	for (std::size_t index = 0u; first != last; ++first, ++index) {
+		if (!r.satisfies(*first))
+			continue;
+		if (heap.size() < k) {
+			heap.emplace_back(first, index);
+			std::push_heap(begin(heap), end(heap), better);
+		} else if (heap.front().get() < *first) {
+			std::pop_heap(begin(heap), end(heap), better);
+			heap.back() = entry(first, index);
+			std::push_heap(begin(heap), end(heap), better);
+		}
+	}
+
+	std::sort_heap(begin(heap), end(heap), better);
+	result.reserve(heap.size());
+	for (const auto & e : heap)
+		result.push_back(e.get());
+	return result;
+}
+
+template <typename Versions>
+auto top_satisfying(const range & r, const Versions & versions, std::size_t k)
+{
+	using std::begin;
+	using std::end;
+	return top_satisfying(r, begin(versions), end(versions), k);
+}
+
+// Returns the highest version satisfying the range of each release line, in ascending
+// order of the release lines. E.g. `release_line::major` yields the latest `1.x.x`,
+// the latest `2.x.x` and so on. Of versions with equal precedence the first one is
+// preferred, like `range::max_satisfying` does.
+//
+// The sequence is traversed once, the latest version of each release line seen so far
+// is kept. Elements of forward iterators are referred to, not copied, until the result
+// is built.
+template <typename InputIt>
+std::vector<typename std::iterator_traits<InputIt>::value_type> latest_per_line(
+	const range & r, InputIt first, InputIt last, release_line line)
+{
+	using entry = detail::query_entry<InputIt>;
+	using number_type = semver::number_type;
+
+	std::map<std::pair<number_type, number_type>, entry> latest;
+	for (std::size_t index = 0u; first != last; ++first, ++index) {
+		decltype(auto) v = *first;
+		if (!r.satisfies(v))
+			continue;
+		const auto key
+			= std::make_pair(v.major(), (line == release_line::minor) ? v.minor() : number_type {0});
+		const auto i = latest.find(key);
+		if (i == latest.end()) {
+			latest.emplace(key, entry(first, index));
+		} else if (i->second.get() < v) {
+			i->second = entry(first, index);
+		}
+	}
+
+	std::vector<typename std::iterator_traits<InputIt>::value_type> result;
+	result.reserve(latest.size());
+	for (const auto & e : latest)
+		result.push_back(e.second.get());
+	return result;
+}
+
+template <typename Versions>
+auto latest_per_line(const range & r, const Versions & versions, release_line line)
+{
+	using std::begin;
+	using std::end;
+	return latest_per_line(r, begin(versions), end(versions), line);
+}
+}
+}
+
+#endif
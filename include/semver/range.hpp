@@ -2,54 +2,348 @@
 #define SEMVER_RANGE_HPP
 
 #include <semver/semver.hpp>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace semver
 {
 inline namespace v1
 {
+class range; // forward
+
 namespace detail
 {
 class node; // forward
+
+// Receives the formatted range in pieces.
+using format_write = void (*)(void * context, const char * s, std::size_t n);
+void format_range(const range & r, format_write write, void * context);
+}
+
+namespace pmr
+{
+class range; // forward
 }
 
+class range_view; // forward
+class semver_view; // forward
+struct key_interval; // forward
+
+// Limits for parsing ranges from untrusted sources. If one of them is exceeded,
+// parsing stops immediately and the range is not ok.
+struct range_limits {
+	// length of the range string in characters
+	std::size_t max_length = std::numeric_limits<std::size_t>::max();
+
+	// number of alternatives, separated by `||`
+	std::size_t max_clauses = std::numeric_limits<std::size_t>::max();
+
+	// number of comparators within one alternative. Ranges are never nested
+	// deeper than alternatives of comparators, this limits the size of one level.
+	std::size_t max_comparators = std::numeric_limits<std::size_t>::max();
+};
+
+// Ends of the interval of `range::between` which are part of it.
+enum class inclusivity {
+	closed, // `>=lo <=hi`
+	open, // `>lo <hi`
+	left_open, // `>lo <=hi`
+	right_open, // `>=lo <hi`
+};
+
 class range final
 {
 public:
 	~range();
 
-	range(const range &) = default;
-	range & operator=(const range &) = default;
+	// copies the syntax tree
+	range(const range & other);
+	range & operator=(const range & other);
 
-	range(range &&) = default;
-	range & operator=(range &&) = default;
+	range(range &&) noexcept;
+	range & operator=(range &&) noexcept;
 
 	range(const std::string & s);
+	range(const std::string & s, const range_limits & limits);
+
+	// Builders, creating the same range as parsing the text in the comment would,
+	// without formatting and parsing it. Build metadata is ignored, invalid versions
+	// and ranges which are not ok result in a range which is not ok.
+
+	static range caret(const semver & v); // `^v`
+	static range tilde(const semver & v); // `~v`
+	static range exact(const semver & v); // `=v`
+	static range between(
+		const semver & lo, const semver & hi, inclusivity i = inclusivity::right_open);
+
+	// Union of at least one range: `r1 || r2 || ...`. The ranges are not modified,
+	// initializer lists copy them.
+	static range any_of(std::initializer_list<range> ranges);
+	static range any_of(const std::vector<range> & ranges);
+
+	// Intersection of at least one range: `r1 r2 ...`. Alternatives are combined
+	// with each other in the order they are formatted, e.g. `a b || a c` for `a`
+	// and `b || c`, the number of alternatives of the result is the product of
+	// their numbers. The result is invalid if it exceeds the limits of alternatives
+	// or of comparators within one alternative, before any of it is built.
+	static range all_of(std::initializer_list<range> ranges, const range_limits & limits = {});
+	static range all_of(const std::vector<range> & ranges, const range_limits & limits = {});
 
 	bool ok() const noexcept { return good_; }
 	explicit operator bool() const noexcept { return ok(); }
 
-	semver max() const noexcept;
-	semver min() const noexcept;
+	semver max() const noexcept { return max_; }
+	semver min() const noexcept { return min_; }
 
 	bool satisfies(const semver & v) const noexcept;
 	bool outside(const semver & v) const noexcept { return !satisfies(v); }
 
+	// Evaluates the range for an encoded version in place, invalid views
+	// never satisfy a range.
+	bool satisfies(const semver_view & v) const noexcept;
+
+	// Evaluates the range for the text of a version, parsed in place without
+	// allocating. Invalid text never satisfies a range.
+	bool satisfies(std::string_view s) const noexcept;
+	bool satisfies(const std::string & s) const noexcept { return satisfies(std::string_view(s)); }
+	bool satisfies(const char * s) const noexcept { return satisfies(std::string_view(s)); }
+
+	// Evaluates the range for the numerical parts of a version, and an optional
+	// prerelease, which must be valid. Nothing is constructed or allocated.
+	bool satisfies(const version_tuple & v) const noexcept;
+	bool satisfies(semver::number_type major, semver::number_type minor,
+		semver::number_type patch, std::string_view prerelease = {}) const noexcept
+	{
+		return satisfies(version_tuple(major, minor, patch, prerelease));
+	}
+
+	// Returns true if the version is greater than all versions satisfying the range.
+	// Ranges no version satisfies are neither greater nor less than any version.
+	bool gtr(const semver & v) const noexcept;
+	bool gtr(const semver_view & v) const noexcept;
+
+	// Returns true if the version is less than all versions satisfying the range.
+	bool ltr(const semver & v) const noexcept;
+	bool ltr(const semver_view & v) const noexcept;
+
 	semver max_satisfying(const std::vector<semver> & versions) const noexcept;
 	semver min_satisfying(const std::vector<semver> & versions) const noexcept;
 
+	// Returns the highest or lowest satisfying version of a sequence, a default
+	// constructed (invalid) one if there is none. Versions are `semver` or `semver_view`,
+	// input iterators are read once, e.g. while parsing a stream of versions.
+	template <typename InputIt>
+	typename std::iterator_traits<InputIt>::value_type max_satisfying(
+		InputIt first, InputIt last) const
+	{
+		return select_satisfying(first, last, [](const auto & v, const auto & best) {
+			return best < v;
+		});
+	}
+
+	template <typename InputIt>
+	typename std::iterator_traits<InputIt>::value_type min_satisfying(
+		InputIt first, InputIt last) const
+	{
+		return select_satisfying(first, last, [](const auto & v, const auto & best) {
+			return v < best;
+		});
+	}
+
+	// Same for containers, arrays and spans of versions.
+	template <typename Versions> auto max_satisfying(const Versions & versions) const
+	{
+		using std::begin;
+		using std::end;
+		return max_satisfying(begin(versions), end(versions));
+	}
+
+	template <typename Versions> auto min_satisfying(const Versions & versions) const
+	{
+		using std::begin;
+		using std::end;
+		return min_satisfying(begin(versions), end(versions));
+	}
+
 	friend bool operator==(const range & r1, const range & r2) noexcept;
-	friend std::string to_string(const range &);
+	friend std::size_t formatted_size(const range & r) noexcept;
+	friend void detail::format_range(const range &, detail::format_write, void *);
+	friend bool encode(const range & r, std::string & out);
+	friend class range_view;
+	friend class pmr::range;
+	friend std::vector<key_interval> key_intervals(const range & r);
 
 private:
+	// lower or upper end of the interval containing all satisfying versions
+	struct bound {
+		semver version = {};
+		bool inclusive = true;
+		bool unbounded = true;
+	};
+
 	bool good_ = false;
 	std::vector<std::unique_ptr<detail::node>> nodes_;
+
+	// computed once at construction
+	bool empty_ = true;
+	bound lower_ = {};
+	bound upper_ = {};
+	semver min_ = {};
+	semver max_ = {};
+
+	// not ok, for invalid encodings and invalid arguments of builders
+	range() = default;
+
+	// takes an already parsed and sorted AST, used by decoding
+	explicit range(std::vector<std::unique_ptr<detail::node>> && nodes);
+
+	static range any_of(const range * first, const range * last);
+	static range all_of(const range * first, const range * last, const range_limits & limits);
+
+	// sorted, disjoint intervals of the versions satisfying the range
+	std::vector<std::pair<bound, bound>> intervals() const;
+
+	void compute_bounds();
+	template <typename V> bool within_bounds(const V & v) const noexcept;
+	template <typename V> bool eval(const V & v) const noexcept;
+
+	// Returns the first satisfying version no other one is preferred to.
+	template <typename InputIt, typename Prefer>
+	typename std::iterator_traits<InputIt>::value_type select_satisfying(
+		InputIt first, InputIt last, Prefer prefer) const
+	{
+		typename std::iterator_traits<InputIt>::value_type result = {};
+		bool found = false;
+		for (; first != last; ++first) {
+			decltype(auto) v = *first;
+			if (satisfies(v) && (!found || prefer(v, result))) {
+				result = v;
+				found = true;
+			}
+		}
+		return result;
+	}
+};
+
+// Lazy view of the versions of a sequence satisfying a range. The range and the
+// sequence must outlive the view. Input iterators can be traversed only once.
+template <typename Iterator> class satisfying_view final
+{
+public:
+	class iterator final
+	{
+	public:
+		using iterator_category
+			= std::conditional_t<std::is_base_of_v<std::forward_iterator_tag,
+									 typename std::iterator_traits<Iterator>::iterator_category>,
+				std::forward_iterator_tag, std::input_iterator_tag>;
+		using value_type = typename std::iterator_traits<Iterator>::value_type;
+		using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+		using pointer = typename std::iterator_traits<Iterator>::pointer;
+		using reference = typename std::iterator_traits<Iterator>::reference;
+
+		iterator() = default;
+
+		iterator(const range * r, Iterator it, Iterator last)
+			: range_(r)
+			, it_(it)
+			, last_(last)
+		{
+			skip();
+		}
+
+		reference operator*() const { return *it_; }
+		pointer operator->() const { return &*it_; }
+
+		iterator & operator++()
+		{
+			++it_;
+			skip();
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			auto tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		friend bool operator==(const iterator & a, const iterator & b) { return a.it_ == b.it_; }
+		friend bool operator!=(const iterator & a, const iterator & b) { return !(a == b); }
+
+	private:
+		const range * range_ = nullptr;
+		Iterator it_ = {};
+		Iterator last_ = {};
+
+		void skip()
+		{
+			while ((it_ != last_) && !range_->satisfies(*it_))
+				++it_;
+		}
+	};
+
+	satisfying_view(const range & r, Iterator first, Iterator last)
+		: range_(&r)
+		, first_(first)
+		, last_(last)
+	{
+	}
+
+	iterator begin() const { return iterator(range_, first_, last_); }
+	iterator end() const { return iterator(range_, last_, last_); }
+
+private:
+	const range * range_;
+	Iterator first_;
+	Iterator last_;
 };
 
+template <typename Iterator>
+satisfying_view<Iterator> satisfying(const range & r, Iterator first, Iterator last)
+{
+	return satisfying_view<Iterator>(r, first, last);
+}
+
+template <typename Versions> auto satisfying(const range & r, const Versions & versions)
+{
+	using std::begin;
+	using std::end;
+	return satisfying(r, begin(versions), end(versions));
+}
+
 std::string to_string(const range & r);
 std::ostream & operator<<(std::ostream & os, const range & r);
 
+// Returns the exact number of characters of the formatted range, as written
+// by `format_to`, `append_to` and `to_string`.
+std::size_t formatted_size(const range & r) noexcept;
+
+// Writes the formatted range to `out` without temporary strings, returns the
+// iterator past the last written character.
+template <typename OutputIt> OutputIt format_to(OutputIt out, const range & r)
+{
+	detail::format_range(
+		r,
+		[](void * context, const char * s, std::size_t n) {
+			auto & it = *static_cast<OutputIt *>(context);
+			it = std::copy(s, s + n, it);
+		},
+		&out);
+	return out;
+}
+
+// Appends the formatted range to `out`, growing it at most once.
+void append_to(std::string & out, const range & r);
+
 bool operator!=(const range & r1, const range & r2) noexcept;
 
 bool intersect(const range &, const range &) noexcept;
@@ -0,0 +1,121 @@
+#ifndef SEMVER_REGISTRY_HPP
+#define SEMVER_REGISTRY_HPP
+
+#include <semver/range.hpp>
+#include <semver/semver.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+// Immutable state of a registry, replaced as a whole by writers.
+struct registry_state {
+	std::vector<semver> versions; // sorted by precedence, unique
+	std::uint64_t generation = 0u;
+};
+}
+
+class version_registry;
+
+// Immutable view of the versions of a registry at one point in time. The versions
+// stay valid as long as the snapshot exists, regardless of concurrent writers.
+//
+// A snapshot must be destroyed by the thread which took it, while it exists the
+// thread delays the reclamation of replaced states of all registries. Snapshots
+// are meant to be short lived, e.g. for one lookup or one request.
+class registry_snapshot final
+{
+public:
+	registry_snapshot(registry_snapshot && other) noexcept;
+	registry_snapshot(const registry_snapshot &) = delete;
+	registry_snapshot & operator=(const registry_snapshot &) = delete;
+	registry_snapshot & operator=(registry_snapshot &&) = delete;
+	~registry_snapshot();
+
+	// Versions in ascending order of precedence, without versions of equal precedence.
+	const std::vector<semver> & versions() const noexcept { return state_->versions; }
+
+	// Number of writes before the snapshot was taken.
+	std::uint64_t generation() const noexcept { return state_->generation; }
+
+	bool contains(const semver & v) const noexcept;
+
+	// Return the highest/lowest version satisfying the range, invalid versions if
+	// none does. Versions outside of the bounds of the range are skipped using
+	// binary search.
+	semver max_satisfying(const range & r) const;
+	semver min_satisfying(const range & r) const;
+
+private:
+	friend class version_registry;
+
+	const detail::registry_state * state_ = nullptr;
+
+	explicit registry_snapshot(const detail::registry_state * state) noexcept;
+};
+
+// Versions of a package read by many threads while being written, e.g. the cache of
+// a registry with concurrent queries and publications.
+//
+// Readers take snapshots without locking and without waiting for writers: taking a
+// snapshot announces the reading thread in an epoch, and loads the current state.
+// Writers copy the state, modify the copy, and publish it atomically. Replaced states
+// are reclaimed by writers once no reader announced in an earlier epoch is still
+// reading. Writers are serialized by a mutex, a write costs time proportional to
+// the number of versions.
+//
+// The first snapshot taken by a thread registers the thread, which takes a lock once
+// and does not allocate.
+class version_registry final
+{
+public:
+	version_registry();
+
+	// Starts with the valid versions of the list, in any order.
+	explicit version_registry(std::vector<semver> versions);
+
+	// There must be no snapshots of the registry left.
+	~version_registry();
+
+	version_registry(const version_registry &) = delete;
+	version_registry & operator=(const version_registry &) = delete;
+
+	registry_snapshot snapshot() const noexcept;
+
+	// Adds a version, returns false if it is invalid or a version of the same
+	// precedence exists already.
+	bool publish(const semver & v);
+
+	// Removes a version, returns false if there is none of the same precedence.
+	bool yank(const semver & v);
+
+	// Publishes and yanks versions in one write, readers see either all of the changes
+	// or none. Versions are yanked after publishing. Returns the number of changes.
+	std::size_t update(const std::vector<semver> & published, const std::vector<semver> & yanked);
+
+	// Frees the replaced states no reader uses anymore, writes do this as well.
+	// Returns the number of replaced states which are still in use.
+	std::size_t reclaim();
+
+private:
+	std::atomic<const detail::registry_state *> state_;
+
+	std::mutex writer_;
+	std::vector<std::pair<std::uint64_t, std::unique_ptr<const detail::registry_state>>> retired_;
+
+	// Publishes the state, the writer mutex must be locked.
+	void replace(std::unique_ptr<detail::registry_state> state);
+	std::size_t reclaim_locked();
+};
+}
+}
+
+#endif
@@ -1,8 +1,13 @@
 #ifndef SERMVER_SEMVER_HPP
 #define SERMVER_SEMVER_HPP
 
+#include <algorithm>
+#include <charconv>
 #include <iosfwd>
+#include <limits>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include <semver/glibc-bugfix.hpp> // must be included last
 
@@ -11,6 +16,11 @@ namespace semver
 {
 inline namespace v1
 {
+namespace detail
+{
+class semver_parser; // forward
+}
+
 // Implementation of semver 2.0.0
 //
 class semver final
@@ -18,6 +28,12 @@ class semver final
 public:
 	using number_type = unsigned long;
 
+	// maximum number of characters of a formatted number, and of the formatted
+	// major, minor and patch, prerelease and build metadata not included
+	static constexpr std::size_t max_number_length
+		= std::numeric_limits<number_type>::digits10 + 1u;
+	static constexpr std::size_t max_core_length = 3u * max_number_length + 2u;
+
 	~semver() = default;
 
 	semver(const semver &) = default;
@@ -52,6 +68,8 @@ public:
 	static semver max() noexcept;
 
 private:
+	friend class detail::semver_parser;
+
 	number_type major_ = {};
 	number_type minor_ = {};
 	number_type patch_ = {};
@@ -66,6 +84,54 @@ private:
 std::string to_string(const semver & v);
 std::ostream & operator<<(std::ostream & os, const semver & v);
 
+namespace detail
+{
+// Writes the formatted version in pieces to `write(const char *, std::size_t)`.
+// `V` is `semver` or any type providing the same accessors.
+template <typename V, typename Write> void format_semver(const V & v, Write && write)
+{
+	if (!v.ok()) {
+		write("<invalid>", 9u);
+		return;
+	}
+
+	char buf[semver::max_core_length];
+	char * p = buf;
+	for (const auto n : {v.major(), v.minor(), v.patch()}) {
+		if (p != buf)
+			*p++ = '.';
+		p = std::to_chars(p, p + semver::max_number_length, n).ptr;
+	}
+	write(buf, static_cast<std::size_t>(p - buf));
+
+	if (!v.prerelease().empty()) {
+		write("-", 1u);
+		write(v.prerelease().data(), v.prerelease().size());
+	}
+	if (!v.build().empty()) {
+		write("+", 1u);
+		write(v.build().data(), v.build().size());
+	}
+}
+}
+
+// Returns the exact number of characters of the formatted version, as written
+// by `format_to`, `append_to` and `str()`.
+std::size_t formatted_size(const semver & v) noexcept;
+
+// Writes the formatted version to `out` without temporary strings, returns the
+// iterator past the last written character.
+template <typename OutputIt> OutputIt format_to(OutputIt out, const semver & v)
+{
+	detail::format_semver(v, [&out](const char * s, std::size_t n) {
+		out = std::copy(s, s + n, out);
+	});
+	return out;
+}
+
+// Appends the formatted version to `out`, growing it at most once.
+void append_to(std::string & out, const semver & v);
+
 bool operator==(const semver & v1, const semver & v2) noexcept;
 bool operator!=(const semver & v1, const semver & v2) noexcept;
 bool operator<(const semver & v1, const semver & v2) noexcept;
@@ -73,6 +139,56 @@ bool operator<=(const semver & v1, const semver & v2) noexcept;
 bool operator>(const semver & v1, const semver & v2) noexcept;
 bool operator>=(const semver & v1, const semver & v2) noexcept;
 int compare(const semver & v1, const semver & v2) noexcept;
+
+// Numerical parts of a version and an optional prerelease, e.g. from columns of a
+// database, to be compared and evaluated without constructing a `semver`. The
+// prerelease is referred to, not copied, and must be valid, it is not checked.
+class version_tuple final
+{
+public:
+	using number_type = semver::number_type;
+
+	constexpr version_tuple(number_type major, number_type minor, number_type patch,
+		std::string_view prerelease = {}) noexcept
+		: major_(major)
+		, minor_(minor)
+		, patch_(patch)
+		, prerelease_(prerelease)
+	{
+	}
+
+	constexpr number_type major() const noexcept { return major_; }
+	constexpr number_type minor() const noexcept { return minor_; }
+	constexpr number_type patch() const noexcept { return patch_; }
+	constexpr std::string_view prerelease() const noexcept { return prerelease_; }
+
+private:
+	number_type major_;
+	number_type minor_;
+	number_type patch_;
+	std::string_view prerelease_;
+};
+
+// Parses version text without constructing a `semver`, the prerelease of the tuple
+// refers to `s`, build metadata is checked but not part of the tuple. Returns no
+// tuple if `s` is not a valid version.
+std::optional<version_tuple> parse_tuple(std::string_view s) noexcept;
+
+bool operator==(const semver & v1, const version_tuple & v2) noexcept;
+bool operator!=(const semver & v1, const version_tuple & v2) noexcept;
+bool operator<(const semver & v1, const version_tuple & v2) noexcept;
+bool operator<=(const semver & v1, const version_tuple & v2) noexcept;
+bool operator>(const semver & v1, const version_tuple & v2) noexcept;
+bool operator>=(const semver & v1, const version_tuple & v2) noexcept;
+int compare(const semver & v1, const version_tuple & v2) noexcept;
+
+bool operator==(const version_tuple & v1, const semver & v2) noexcept;
+bool operator!=(const version_tuple & v1, const semver & v2) noexcept;
+bool operator<(const version_tuple & v1, const semver & v2) noexcept;
+bool operator<=(const version_tuple & v1, const semver & v2) noexcept;
+bool operator>(const version_tuple & v1, const semver & v2) noexcept;
+bool operator>=(const version_tuple & v1, const semver & v2) noexcept;
+int compare(const version_tuple & v1, const semver & v2) noexcept;
 }
 }
 
@@ -0,0 +1,51 @@
+#ifndef SEMVER_SORT_HPP
+#define SEMVER_SORT_HPP
+
+#include <semver/semver.hpp>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+enum class execution { sequential, parallel };
+
+// Sorts versions in ascending order of precedence, the resulting order is the same
+// as sorting with `operator<`.
+//
+// The numerical core (major, minor, patch) is radix sorted, prereleases are compared
+// only among versions with the same core. With `execution::parallel`, large inputs
+// are sorted using multiple threads.
+void sort(std::vector<semver>::iterator first, std::vector<semver>::iterator last,
+	execution policy = execution::sequential);
+
+// Same as `sort`, additionally versions of equal precedence (e.g. differing only in
+// build metadata) keep their relative order.
+void stable_sort(std::vector<semver>::iterator first, std::vector<semver>::iterator last,
+	execution policy = execution::sequential);
+
+// Removes consecutive versions of equal precedence, except the first one, from
+// a sorted sequence. Returns the end of the resulting sequence.
+std::vector<semver>::iterator unique(
+	std::vector<semver>::iterator first, std::vector<semver>::iterator last);
+
+inline void sort(std::vector<semver> & versions, execution policy = execution::sequential)
+{
+	sort(versions.begin(), versions.end(), policy);
+}
+
+inline void stable_sort(
+	std::vector<semver> & versions, execution policy = execution::sequential)
+{
+	stable_sort(versions.begin(), versions.end(), policy);
+}
+
+// Removes all but the first of versions with equal precedence from a sorted vector.
+inline void unique(std::vector<semver> & versions)
+{
+	versions.erase(unique(versions.begin(), versions.end()), versions.end());
+}
+}
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef SEMVER_STATISTICS_HPP
+#define SEMVER_STATISTICS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace semver
+{
+inline namespace v1
+{
+// Reasons of failed parsing of versions and ranges.
+enum class parse_failure : std::uint8_t {
+	empty, // empty string
+	version_core, // invalid major, minor or patch
+	prerelease, // invalid prerelease
+	build, // invalid build metadata
+	trailing, // characters after a valid version
+	range_syntax, // invalid range
+	range_limit, // range exceeded its `range_limits`
+};
+
+constexpr std::size_t parse_failure_count = 7u;
+
+enum class latency : std::uint8_t {
+	version_parse, // construction of a version from a string
+	range_parse, // construction of a range from a string
+	satisfies, // `range::satisfies`
+};
+
+constexpr std::size_t latency_count = 3u;
+
+// Histogram of sampled durations, bucket `i` counts durations of less than
+// `2^(i+1)` nanoseconds not counted by a lower bucket, the last bucket all longer ones.
+struct latency_histogram {
+	static constexpr std::size_t bucket_count = 32u;
+
+	std::array<std::uint64_t, bucket_count> buckets = {};
+	std::uint64_t samples = 0u;
+	std::uint64_t total_ns = 0u;
+};
+
+struct statistics {
+	std::uint64_t versions_parsed = 0u; // successfully
+	std::uint64_t ranges_parsed = 0u; // successfully
+	std::array<std::uint64_t, parse_failure_count> parse_failures = {};
+
+	std::uint64_t satisfies_calls = 0u; // calls of `range::satisfies`
+	std::uint64_t nodes_visited = 0u; // range nodes evaluated by `satisfies`
+
+	std::uint64_t comparisons = 0u; // calls of `operator<` of versions
+	std::uint64_t prerelease_comparisons = 0u; // of them comparing prereleases
+
+	std::array<latency_histogram, latency_count> latencies = {};
+
+	std::uint64_t failures(parse_failure reason) const noexcept
+	{
+		return parse_failures[static_cast<std::size_t>(reason)];
+	}
+
+	const latency_histogram & latencies_of(latency l) const noexcept
+	{
+		return latencies[static_cast<std::size_t>(l)];
+	}
+};
+
+// Returns true if the library was built with `ENABLE_STATISTICS`. Otherwise
+// nothing is counted, the instrumentation is not compiled in at all, and all
+// statistics are reported as zero.
+bool statistics_enabled() noexcept;
+
+// Returns the statistics of all threads, including finished ones, since the
+// start of the program or the last reset. Counters are kept per thread and are
+// summed up by this function, a snapshot taken while other threads are working
+// is therefore not exact.
+statistics statistics_snapshot() noexcept;
+
+// Restarts counting, subsequent snapshots do not contain what was counted until now.
+void reset_statistics() noexcept;
+
+// Sets how often latencies are measured: one in `n` operations of each thread, 0 disables
+// measuring. Reading the clock is the most expensive part of the instrumentation,
+// the default is 64.
+void set_latency_sampling(unsigned int n) noexcept;
+}
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef SEMVER_TRACKER_HPP
+#define SEMVER_TRACKER_HPP
+
+#include <semver/range.hpp>
+#include <semver/semver.hpp>
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace semver
+{
+inline namespace v1
+{
+// Change of the highest version satisfying a range of a `max_satisfying_tracker`.
+struct resolution_change {
+	std::size_t id; // of the range
+	semver old_best; // invalid if no version satisfied the range
+	semver new_best; // invalid if no version satisfies the range anymore
+};
+
+// Highest satisfying versions of many ranges, maintained while versions of one
+// package are published and yanked.
+//
+// Ranges are indexed by the major numbers of the versions they may be satisfied by.
+// Publishing a version checks only the ranges of its major number, and ranges spanning
+// many majors (e.g. `>=1.0.0`). Yanking a version recomputes only the ranges it was the
+// highest satisfying version of, searching downwards from it.
+class max_satisfying_tracker final
+{
+public:
+	// Ranges spanning more majors are checked for every published version.
+	static constexpr semver::number_type max_indexed_majors = 16u;
+
+	max_satisfying_tracker() = default;
+
+	// Registers the range, returns its id. The highest satisfying version is
+	// determined immediately, see `best`. Invalid ranges are never satisfied.
+	std::size_t subscribe(range r);
+
+	// Removes the range, the id is not reused.
+	void unsubscribe(std::size_t id);
+
+	// Returns the highest satisfying version of the range, invalid if there is none.
+	const semver & best(std::size_t id) const noexcept { return subscriptions_[id].best; }
+
+	// Versions known to the tracker, in ascending order of precedence.
+	const std::vector<semver> & versions() const noexcept { return versions_; }
+
+	// Adds the version and returns the ranges it became the highest satisfying
+	// version of. Invalid versions and versions with the precedence of a known one
+	// are ignored.
+	std::vector<resolution_change> publish(const semver & v);
+
+	// Removes the version of the same precedence and returns the ranges which
+	// resolve to another version now.
+	std::vector<resolution_change> yank(const semver & v);
+
+private:
+	struct subscription {
+		range r;
+		semver best;
+		bool active;
+		bool wide; // not indexed by major
+		semver::number_type first_major;
+		semver::number_type last_major;
+	};
+
+	std::vector<semver> versions_; // sorted, unique
+
+	std::vector<subscription> subscriptions_;
+	std::unordered_map<semver::number_type, std::vector<std::size_t>> by_major_;
+	std::vector<std::size_t> wide_;
+	std::map<semver, std::vector<std::size_t>> by_best_;
+
+	// highest version satisfying the range which is less than `last`
+	semver search(const range & r, std::vector<semver>::const_iterator last) const;
+
+	void set_best(std::size_t id, const semver & v);
+};
+}
+}
+
+#endif
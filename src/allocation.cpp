@@ -0,0 +1,186 @@
+#include <semver/allocation.hpp>
+
+#if defined(SEMVER_ALLOCATION_COUNTING)
+	#include <cstdlib>
+	#include <new>
+#endif
+
+namespace semver
+{
+inline namespace v1
+{
+#if defined(SEMVER_ALLOCATION_COUNTING)
+namespace detail
+{
+// plain counters, trivially constructible, therefore usable already during
+// static initialization and without allocating themselves.
+thread_local std::size_t allocation_count = 0u;
+thread_local std::size_t allocation_bytes = 0u;
+
+static void * counted_allocate(std::size_t size) noexcept
+{
+	++allocation_count;
+	allocation_bytes += size;
+	return std::malloc(size ? size : 1u);
+}
+
+// Over-aligned allocations, `alignment` is a power of two greater than the
+// default alignment. They must be freed by `aligned_free`.
+static void * counted_allocate(std::size_t size, std::size_t alignment) noexcept
+{
+	++allocation_count;
+	allocation_bytes += size;
+	#if defined(_MSC_VER)
+	return _aligned_malloc(size ? size : 1u, alignment);
+	#else
+	// the size must be a multiple of the alignment
+	const auto n = (size + alignment - 1u) / alignment * alignment;
+	return std::aligned_alloc(alignment, n ? n : alignment);
+	#endif
+}
+
+static void aligned_free(void * p) noexcept
+{
+	#if defined(_MSC_VER)
+	_aligned_free(p);
+	#else
+	std::free(p);
+	#endif
+}
+}
+
+bool allocation_counting_enabled() noexcept
+{
+	return true;
+}
+
+allocation_stats thread_allocations() noexcept
+{
+	return {detail::allocation_count, detail::allocation_bytes};
+}
+#else
+bool allocation_counting_enabled() noexcept
+{
+	return false;
+}
+
+allocation_stats thread_allocations() noexcept
+{
+	return {};
+}
+#endif
+}
+}
+
+#if defined(SEMVER_ALLOCATION_COUNTING)
+// Replacements of the global allocation functions. They are part of this
+// translation unit, which is linked as soon as the allocation API is used.
+
+void * operator new(std::size_t size)
+{
+	if (auto p = semver::detail::counted_allocate(size))
+		return p;
+	throw std::bad_alloc {};
+}
+
+void * operator new[](std::size_t size)
+{
+	if (auto p = semver::detail::counted_allocate(size))
+		return p;
+	throw std::bad_alloc {};
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+	return semver::detail::counted_allocate(size);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+	return semver::detail::counted_allocate(size);
+}
+
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+	if (auto p = semver::detail::counted_allocate(size, static_cast<std::size_t>(alignment)))
+		return p;
+	throw std::bad_alloc {};
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment)
+{
+	if (auto p = semver::detail::counted_allocate(size, static_cast<std::size_t>(alignment)))
+		return p;
+	throw std::bad_alloc {};
+}
+
+void * operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+	return semver::detail::counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+	return semver::detail::counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void * p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void * p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void * p, const std::nothrow_t &) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void * p, const std::nothrow_t &) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void * p, std::align_val_t) noexcept
+{
+	semver::detail::aligned_free(p);
+}
+
+void operator delete[](void * p, std::align_val_t) noexcept
+{
+	semver::detail::aligned_free(p);
+}
+
+void operator delete(void * p, std::size_t, std::align_val_t) noexcept
+{
+	semver::detail::aligned_free(p);
+}
+
+void operator delete[](void * p, std::size_t, std::align_val_t) noexcept
+{
+	semver::detail::aligned_free(p);
+}
+
+void operator delete(void * p, std::align_val_t, const std::nothrow_t &) noexcept
+{
+	semver::detail::aligned_free(p);
+}
+
+void operator delete[](void * p, std::align_val_t, const std::nothrow_t &) noexcept
+{
+	semver::detail::aligned_free(p);
+}
+#endif
@@ -0,0 +1,334 @@
+#include <semver/binary.hpp>
+#include "detail/precedence.hpp"
+#include "detail/range_node.hpp"
+#include "detail/semver_parser.hpp"
+#include <iterator>
+#include <limits>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+namespace
+{
+constexpr char binary_magic[] = {'S', 'V', 'B'};
+
+// operator codes of comparators, part of the format, do not change
+enum class binary_op : std::uint8_t { eq = 0u, lt = 1u, le = 2u, gt = 3u, ge = 4u };
+
+void write_varint(std::string & out, std::uint64_t n)
+{
+	while (n >= 0x80u) {
+		out += static_cast<char>((n & 0x7fu) | 0x80u);
+		n >>= 7;
+	}
+	out += static_cast<char>(n);
+}
+
+// Reads a varint, advances `data` past it. Returns false if the data ends
+// within the varint or the value does not fit into `T`.
+template <typename T> bool read_varint(std::string_view & data, T & n) noexcept
+{
+	constexpr unsigned int bits = std::numeric_limits<T>::digits;
+
+	n = 0u;
+	for (unsigned int shift = 0u; !data.empty(); shift += 7u) {
+		const auto b = static_cast<std::uint8_t>(data.front());
+		data.remove_prefix(1u);
+
+		const T group = b & 0x7fu;
+		if (shift >= bits)
+			return false;
+		if ((bits - shift < 7u) && ((group >> (bits - shift)) != 0u))
+			return false;
+		n |= group << shift;
+		if ((b & 0x80u) == 0u)
+			return true;
+	}
+	return false;
+}
+
+bool read_string(std::string_view & data, std::string_view & s) noexcept
+{
+	std::size_t n = 0u;
+	if (!read_varint(data, n) || (n > data.size()))
+		return false;
+	s = data.substr(0u, n);
+	data.remove_prefix(n);
+	return true;
+}
+
+void write_string(std::string & out, const std::string & s)
+{
+	write_varint(out, s.size());
+	out += s;
+}
+
+void write_version(std::string & out, const semver & v)
+{
+	write_varint(out, v.major());
+	write_varint(out, v.minor());
+	write_varint(out, v.patch());
+	write_string(out, v.prerelease());
+	write_string(out, v.build());
+}
+
+bool to_binary_op(node::type t, binary_op & op) noexcept
+{
+	switch (t) {
+		case node::type::op_eq:
+			op = binary_op::eq;
+			return true;
+		case node::type::op_lt:
+			op = binary_op::lt;
+			return true;
+		case node::type::op_le:
+			op = binary_op::le;
+			return true;
+		case node::type::op_gt:
+			op = binary_op::gt;
+			return true;
+		case node::type::op_ge:
+			op = binary_op::ge;
+			return true;
+		case node::type::op_and:
+		case node::type::op_or:
+			break;
+	}
+	return false;
+}
+
+bool valid_binary_op(std::uint8_t op) noexcept
+{
+	return op <= static_cast<std::uint8_t>(binary_op::ge);
+}
+
+bool write_comparator(std::string & out, const node & n)
+{
+	binary_op op = binary_op::eq;
+	if (!n.is_leaf() || !to_binary_op(n.get_type(), op))
+		return false;
+	out += static_cast<char>(op);
+	write_version(out, n.get_version());
+	return true;
+}
+
+node create_comparator(binary_op op, const semver & v)
+{
+	switch (op) {
+		case binary_op::eq:
+			return node::create_eq(v);
+		case binary_op::lt:
+			return node::create_lt(v);
+		case binary_op::le:
+			return node::create_le(v);
+		case binary_op::gt:
+			return node::create_gt(v);
+		case binary_op::ge:
+			break;
+	}
+	return node::create_ge(v);
+}
+
+bool eval_comparator(binary_op op, const semver_view & c, const semver & v) noexcept
+{
+	switch (op) {
+		case binary_op::eq:
+			return c == v;
+		case binary_op::lt:
+			return v < c;
+		case binary_op::le:
+			return !(c < v);
+		case binary_op::gt:
+			return c < v;
+		case binary_op::ge:
+			return !(v < c);
+	}
+	return false;
+}
+
+// Calls `f(op, version)` for all comparators of an alternative and advances `data`
+// past the alternative. Stops early if `f` returns false, returns false then.
+template <typename F> bool for_each_comparator(std::string_view & data, F f) noexcept
+{
+	std::size_t comparators = 0u;
+	read_varint(data, comparators);
+	bool result = true;
+	for (std::size_t i = 0u; i < comparators; ++i) {
+		const auto op = static_cast<binary_op>(data.front());
+		data.remove_prefix(1u);
+		const auto c = semver_view(data);
+		data.remove_prefix(c.size());
+		if (result)
+			result = f(op, c);
+	}
+	return result;
+}
+}
+}
+
+void encode_header(std::string & out)
+{
+	out.append(std::begin(detail::binary_magic), std::end(detail::binary_magic));
+	out += static_cast<char>(binary_format_version);
+}
+
+std::uint8_t decode_header(std::string_view data) noexcept
+{
+	if ((data.size() < binary_header_size)
+		|| (data.substr(0u, sizeof(detail::binary_magic))
+			!= std::string_view(detail::binary_magic, sizeof(detail::binary_magic))))
+		return 0u;
+	return static_cast<std::uint8_t>(data[sizeof(detail::binary_magic)]);
+}
+
+bool encode(const semver & v, std::string & out)
+{
+	if (!v.ok())
+		return false;
+	detail::write_version(out, v);
+	return true;
+}
+
+bool encode(const range & r, std::string & out)
+{
+	if (!r.ok())
+		return false;
+
+	const auto size = out.size();
+	detail::write_varint(out, r.nodes_.size());
+	for (const auto & n : r.nodes_) {
+		bool good = true;
+		if (n->is_leaf()) {
+			detail::write_varint(out, 1u);
+			good = detail::write_comparator(out, *n);
+		} else {
+			detail::write_varint(out, static_cast<std::size_t>(std::distance(begin(*n), end(*n))));
+			for (const auto & c : *n)
+				good = good && detail::write_comparator(out, *c);
+		}
+		if (!good) {
+			out.resize(size);
+			return false;
+		}
+	}
+	return true;
+}
+
+semver_view::semver_view(std::string_view data) noexcept
+{
+	const auto size = data.size();
+	good_ = detail::read_varint(data, major_) && detail::read_varint(data, minor_)
+		&& detail::read_varint(data, patch_) && detail::read_string(data, prerelease_)
+		&& detail::read_string(data, build_);
+	if (good_)
+		size_ = size - data.size();
+}
+
+semver semver_view::to_semver() const
+{
+	if (!good_)
+		return semver::invalid();
+	return detail::semver_parser::create(major_, minor_, patch_, prerelease_, build_);
+}
+
+bool operator==(const semver_view & v1, const semver & v2) noexcept
+{
+	return detail::same_precedence(v1, v2);
+}
+
+bool operator<(const semver_view & v1, const semver & v2) noexcept
+{
+	return detail::precedes(v1, v2);
+}
+
+bool operator<(const semver & v1, const semver_view & v2) noexcept
+{
+	return detail::precedes(v1, v2);
+}
+
+bool operator==(const semver_view & v1, const semver_view & v2) noexcept
+{
+	return detail::same_precedence(v1, v2);
+}
+
+bool operator<(const semver_view & v1, const semver_view & v2) noexcept
+{
+	return detail::precedes(v1, v2);
+}
+
+range_view::range_view(std::string_view data) noexcept
+{
+	const auto start = data;
+
+	std::size_t alternatives = 0u;
+	if (!detail::read_varint(data, alternatives) || (alternatives == 0u))
+		return;
+	for (std::size_t i = 0u; i < alternatives; ++i) {
+		std::size_t comparators = 0u;
+		if (!detail::read_varint(data, comparators) || (comparators == 0u))
+			return;
+		for (std::size_t j = 0u; j < comparators; ++j) {
+			if (data.empty() || !detail::valid_binary_op(static_cast<std::uint8_t>(data.front())))
+				return;
+			data.remove_prefix(1u);
+			const auto c = semver_view(data);
+			if (!c.ok())
+				return;
+			data.remove_prefix(c.size());
+		}
+	}
+
+	good_ = true;
+	data_ = start.substr(0u, start.size() - data.size());
+}
+
+bool range_view::satisfies(const semver & v) const noexcept
+{
+	if (!good_)
+		return false;
+
+	auto data = data_;
+	std::size_t alternatives = 0u;
+	detail::read_varint(data, alternatives);
+
+	// all alternatives are implicit `or`, all comparators within one implicit `and`
+	for (std::size_t i = 0u; i < alternatives; ++i) {
+		if (detail::for_each_comparator(data, [&v](detail::binary_op op, const semver_view & c) {
+				return detail::eval_comparator(op, c, v);
+			}))
+			return true;
+	}
+	return false;
+}
+
+range range_view::to_range() const
+{
+	if (!good_)
+		return range();
+
+	auto data = data_;
+	std::size_t alternatives = 0u;
+	detail::read_varint(data, alternatives);
+
+	std::vector<std::unique_ptr<detail::node>> nodes;
+	nodes.reserve(alternatives);
+	for (std::size_t i = 0u; i < alternatives; ++i) {
+		std::vector<std::unique_ptr<detail::node>> leafs;
+		detail::for_each_comparator(data, [&leafs](detail::binary_op op, const semver_view & c) {
+			leafs.push_back(
+				std::make_unique<detail::node>(detail::create_comparator(op, c.to_semver())));
+			return true;
+		});
+		if (leafs.size() == 1u)
+			nodes.push_back(std::move(leafs.front()));
+		else
+			nodes.push_back(
+				std::make_unique<detail::node>(detail::node::create_and(std::move(leafs))));
+	}
+	return range(std::move(nodes));
+}
+}
+}
@@ -0,0 +1,339 @@
+#include <semver/catalog.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define SEMVER_CATALOG_MMAP
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+namespace
+{
+constexpr char catalog_magic[] = {'S', 'V', 'C'};
+constexpr std::size_t catalog_header_size = 16u;
+constexpr std::size_t catalog_entry_size = 40u;
+constexpr std::size_t catalog_offset_size = 4u;
+
+template <typename T> T read_le(const char * p, std::size_t n) noexcept
+{
+	T v = 0u;
+	for (std::size_t i = 0u; i < n; ++i)
+		v |= static_cast<T>(static_cast<unsigned char>(p[i])) << (8u * i);
+	return v;
+}
+
+std::uint64_t read_u64(std::string_view data, std::size_t pos) noexcept
+{
+	return read_le<std::uint64_t>(data.data() + pos, 8u);
+}
+
+std::uint32_t read_u32(std::string_view data, std::size_t pos) noexcept
+{
+	return read_le<std::uint32_t>(data.data() + pos, 4u);
+}
+
+void write_le(std::string & out, std::uint64_t v, std::size_t n)
+{
+	for (std::size_t i = 0u; i < n; ++i)
+		out += static_cast<char>((v >> (8u * i)) & 0xffu);
+}
+
+// Returns true if [offset, offset + size) lies within data of size `total`.
+bool within(std::uint64_t offset, std::uint64_t size, std::size_t total) noexcept
+{
+	return (offset <= total) && (size <= total - offset);
+}
+
+struct catalog_entry {
+	std::uint64_t name_offset;
+	std::uint64_t name_size;
+	std::uint64_t block_offset;
+	std::uint64_t block_size;
+	std::uint64_t count;
+};
+
+catalog_entry read_entry(std::string_view data, std::size_t i) noexcept
+{
+	const auto pos = catalog_header_size + i * catalog_entry_size;
+	return {read_u64(data, pos), read_u64(data, pos + 8u), read_u64(data, pos + 16u),
+		read_u64(data, pos + 24u), read_u64(data, pos + 32u)};
+}
+}
+}
+
+catalog_versions::catalog_versions(std::string_view block, std::size_t count) noexcept
+	: count_(std::min(count, block.size() / detail::catalog_offset_size))
+{
+	// a block too short for the offsets is truncated to the versions it can hold
+	offsets_ = block.substr(0u, count_ * detail::catalog_offset_size);
+	data_ = block.substr(count_ * detail::catalog_offset_size);
+}
+
+semver_view catalog_versions::operator[](std::size_t i) const noexcept
+{
+	if (i >= count_)
+		return {};
+	const auto offset = detail::read_u32(offsets_, i * detail::catalog_offset_size);
+	if (offset > data_.size())
+		return {};
+	return semver_view(data_.substr(offset));
+}
+
+std::pair<std::size_t, std::size_t> catalog_versions::candidates(const range & r) const noexcept
+{
+	// versions are sorted, all versions less than the range are at the beginning,
+	// all greater than the range at the end.
+	std::size_t lo = 0u;
+	std::size_t hi = count_;
+	while (lo < hi) {
+		const auto mid = lo + (hi - lo) / 2u;
+		if (r.ltr((*this)[mid]))
+			lo = mid + 1u;
+		else
+			hi = mid;
+	}
+	const auto first = lo;
+	hi = count_;
+	while (lo < hi) {
+		const auto mid = lo + (hi - lo) / 2u;
+		if (r.gtr((*this)[mid]))
+			hi = mid;
+		else
+			lo = mid + 1u;
+	}
+	return {first, lo};
+}
+
+semver_view catalog_versions::max_satisfying(const range & r) const noexcept
+{
+	if (!r.ok())
+		return {};
+	const auto [first, last] = candidates(r);
+	for (auto i = last; i > first; --i) {
+		const auto v = (*this)[i - 1u];
+		if (r.satisfies(v))
+			return v;
+	}
+	return {};
+}
+
+semver_view catalog_versions::min_satisfying(const range & r) const noexcept
+{
+	if (!r.ok())
+		return {};
+	const auto [first, last] = candidates(r);
+	for (auto i = first; i < last; ++i) {
+		const auto v = (*this)[i];
+		if (r.satisfies(v))
+			return v;
+	}
+	return {};
+}
+
+std::vector<semver_view> catalog_versions::satisfying(const range & r) const
+{
+	std::vector<semver_view> result;
+	if (!r.ok())
+		return result;
+	const auto [first, last] = candidates(r);
+	for (auto i = first; i < last; ++i) {
+		const auto v = (*this)[i];
+		if (r.satisfies(v))
+			result.push_back(v);
+	}
+	return result;
+}
+
+catalog::catalog(std::string_view data) noexcept
+{
+	if ((data.size() < detail::catalog_header_size)
+		|| (data.substr(0u, sizeof(detail::catalog_magic))
+			!= std::string_view(detail::catalog_magic, sizeof(detail::catalog_magic)))
+		|| (static_cast<std::uint8_t>(data[sizeof(detail::catalog_magic)])
+			!= catalog_format_version))
+		return;
+
+	const auto count = detail::read_u64(data, 8u);
+	if ((count > (data.size() - detail::catalog_header_size) / detail::catalog_entry_size))
+		return;
+
+	// the index is checked once, versions are checked when they are read
+	for (std::size_t i = 0u; i < count; ++i) {
+		const auto e = detail::read_entry(data, i);
+		if (!detail::within(e.name_offset, e.name_size, data.size())
+			|| !detail::within(e.block_offset, e.block_size, data.size())
+			|| (e.count > e.block_size / detail::catalog_offset_size))
+			return;
+	}
+
+	data_ = data;
+	count_ = static_cast<std::size_t>(count);
+	good_ = true;
+}
+
+std::string_view catalog::package(std::size_t i) const noexcept
+{
+	if (i >= count_)
+		return {};
+	const auto e = detail::read_entry(data_, i);
+	return data_.substr(e.name_offset, e.name_size);
+}
+
+catalog_versions catalog::versions(std::size_t i) const noexcept
+{
+	if (i >= count_)
+		return {};
+	const auto e = detail::read_entry(data_, i);
+	return catalog_versions(data_.substr(e.block_offset, e.block_size), e.count);
+}
+
+catalog_versions catalog::versions(std::string_view package) const noexcept
+{
+	std::size_t lo = 0u;
+	std::size_t hi = count_;
+	while (lo < hi) {
+		const auto mid = lo + (hi - lo) / 2u;
+		if (this->package(mid) < package)
+			lo = mid + 1u;
+		else
+			hi = mid;
+	}
+	if ((lo < count_) && (this->package(lo) == package))
+		return versions(lo);
+	return {};
+}
+
+catalog_file::catalog_file(const std::string & path)
+{
+#if defined(SEMVER_CATALOG_MMAP)
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return;
+	struct stat st;
+	if ((::fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+		void * p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ,
+			MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED) {
+			mapped_ = static_cast<const char *>(p);
+			size_ = static_cast<std::size_t>(st.st_size);
+			catalog_ = catalog(std::string_view(mapped_, size_));
+		}
+	}
+	::close(fd);
+#else
+	std::FILE * f = std::fopen(path.c_str(), "rb");
+	if (!f)
+		return;
+	char buf[64 * 1024];
+	std::size_t n = 0u;
+	while ((n = std::fread(buf, 1u, sizeof(buf), f)) > 0u)
+		storage_.append(buf, n);
+	const bool good = !std::ferror(f);
+	std::fclose(f);
+	if (good)
+		catalog_ = catalog(storage_);
+#endif
+}
+
+catalog_file::~catalog_file()
+{
+#if defined(SEMVER_CATALOG_MMAP)
+	if (mapped_)
+		::munmap(const_cast<char *>(mapped_), size_);
+#endif
+}
+
+bool catalog_builder::add(std::string_view package, const semver & v)
+{
+	if (!v.ok())
+		return false;
+	auto i = packages_.find(package);
+	if (i == packages_.end())
+		i = packages_.emplace(std::string(package), std::vector<semver> {}).first;
+	i->second.push_back(v);
+	return true;
+}
+
+std::string catalog_builder::build() const
+{
+	const auto count = packages_.size();
+
+	// blocks are built first, their sizes are needed for the index
+	std::string names;
+	std::string blocks;
+	std::vector<detail::catalog_entry> entries;
+	entries.reserve(count);
+	std::vector<semver> versions;
+	std::string encoded;
+	for (const auto & [name, unsorted] : packages_) {
+		versions = unsorted;
+		// the build is the tie-breaker, identical versions become adjacent
+		std::sort(begin(versions), end(versions), [](const semver & a, const semver & b) {
+			return (a < b) || ((a == b) && (a.build() < b.build()));
+		});
+		versions.erase(std::unique(begin(versions), end(versions),
+						   [](const semver & a, const semver & b) {
+							   return (a == b) && (a.build() == b.build());
+						   }),
+			end(versions));
+
+		encoded.clear();
+		std::string offsets;
+		for (const auto & v : versions) {
+			if (encoded.size() > std::numeric_limits<std::uint32_t>::max())
+				return {};
+			detail::write_le(offsets, encoded.size(), detail::catalog_offset_size);
+			encode(v, encoded);
+		}
+
+		entries.push_back({names.size(), name.size(), blocks.size(),
+			offsets.size() + encoded.size(), versions.size()});
+		names += name;
+		blocks += offsets;
+		blocks += encoded;
+	}
+
+	const auto names_offset = detail::catalog_header_size + count * detail::catalog_entry_size;
+	const auto blocks_offset = names_offset + names.size();
+
+	std::string out;
+	out.reserve(blocks_offset + blocks.size());
+	out.append(std::begin(detail::catalog_magic), std::end(detail::catalog_magic));
+	out += static_cast<char>(catalog_format_version);
+	detail::write_le(out, 0u, 4u);
+	detail::write_le(out, count, 8u);
+	for (const auto & e : entries) {
+		detail::write_le(out, names_offset + e.name_offset, 8u);
+		detail::write_le(out, e.name_size, 8u);
+		detail::write_le(out, blocks_offset + e.block_offset, 8u);
+		detail::write_le(out, e.block_size, 8u);
+		detail::write_le(out, e.count, 8u);
+	}
+	out += names;
+	out += blocks;
+	return out;
+}
+
+bool catalog_builder::write(const std::string & path) const
+{
+	const auto data = build();
+	if (data.empty())
+		return false;
+	std::FILE * f = std::fopen(path.c_str(), "wb");
+	if (!f)
+		return false;
+	const bool good = std::fwrite(data.data(), 1u, data.size(), f) == data.size();
+	return (std::fclose(f) == 0) && good;
+}
+}
+}
@@ -0,0 +1,186 @@
+#include <semver/coerce.hpp>
+#include "detail/semver_parser.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+namespace
+{
+// like node-semver, at most 16 digits per number, less if they do not fit
+constexpr std::size_t max_coerce_digits
+	= std::min<std::size_t>(16u, std::numeric_limits<semver::number_type>::digits10);
+
+bool is_digit(char c) noexcept
+{
+	return (c >= '0') && (c <= '9');
+}
+
+bool is_identifier_char(char c) noexcept
+{
+	return is_digit(c) || ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '-');
+}
+
+// Returns a mask with the high bit set in each byte of `w` being a digit.
+constexpr std::uint64_t digit_mask(std::uint64_t w) noexcept
+{
+	constexpr std::uint64_t high = 0x8080808080808080u;
+	const auto low = w & ~high;
+	const auto at_least_0 = (low + 0x5050505050505050u) & high; // byte >= '0'
+	const auto above_9 = (low + 0x4646464646464646u) & high; // byte > '9'
+	return at_least_0 & ~above_9 & ~w;
+}
+
+// Returns the position of the first digit at or after `pos`, the size if there is none.
+// Text is skipped in words of 8 bytes, which is what makes scanning large buffers
+// with few versions cheap.
+std::size_t find_digit(std::string_view s, std::size_t pos) noexcept
+{
+	while (pos + 8u <= s.size()) {
+		std::uint64_t w;
+		std::memcpy(&w, s.data() + pos, sizeof(w));
+		if (digit_mask(w) != 0u)
+			break;
+		pos += 8u;
+	}
+	while ((pos < s.size()) && !is_digit(s[pos]))
+		++pos;
+	return pos;
+}
+
+// Reads a number at `pos`, which must be a digit. Numbers with too many digits and
+// numbers followed by another digit are not valid.
+bool read_number(std::string_view s, std::size_t & pos, semver::number_type & n) noexcept
+{
+	std::size_t i = pos;
+	n = 0u;
+	for (; (i < s.size()) && is_digit(s[i]); ++i) {
+		if (i - pos == max_coerce_digits)
+			return false;
+		n = n * 10u + static_cast<semver::number_type>(s[i] - '0');
+	}
+	pos = i;
+	return true;
+}
+
+// Reads a dot separated list of identifiers at `pos`, as many of them as valid.
+// Returns the number of characters read.
+std::size_t read_identifiers(std::string_view s, std::size_t pos, bool prerelease) noexcept
+{
+	std::size_t valid = 0u;
+	for (std::size_t i = pos;;) {
+		const auto start = i;
+		bool numeric = true;
+		for (; (i < s.size()) && is_identifier_char(s[i]); ++i)
+			numeric &= is_digit(s[i]);
+		if (i == start)
+			break;
+		if (prerelease && numeric && (s[start] == '0') && (i - start > 1u))
+			break;
+		valid = i - pos;
+		if ((i >= s.size()) || (s[i] != '.'))
+			break;
+		++i;
+	}
+	return valid;
+}
+}
+}
+
+semver coerce_match::to_semver() const
+{
+	return detail::semver_parser::create(major, minor, patch, prerelease, build);
+}
+
+bool coerce_scanner::next(coerce_match & m) noexcept
+{
+	using namespace detail;
+
+	for (;;) {
+		const auto start = find_digit(text_, pos_);
+		if (start >= text_.size()) {
+			pos_ = text_.size();
+			return false;
+		}
+
+		// the first number must not be preceded by a digit, this is guaranteed
+		// because all digits before `pos_` were consumed
+		auto pos = start;
+		semver::number_type major = 0u;
+		if (!read_number(text_, pos, major)) {
+			pos_ = std::find_if_not(text_.begin() + pos, text_.end(), is_digit) - text_.begin();
+			continue;
+		}
+
+		semver::number_type parts[2] = {0u, 0u};
+		for (auto & part : parts) {
+			if ((pos + 1u >= text_.size()) || (text_[pos] != '.') || !is_digit(text_[pos + 1u]))
+				break;
+			auto p = pos + 1u;
+			if (!read_number(text_, p, part)) {
+				part = 0u;
+				break;
+			}
+			pos = p;
+		}
+
+		m = coerce_match();
+		m.major = major;
+		m.minor = parts[0];
+		m.patch = parts[1];
+
+		// prerelease and build metadata are skipped even if not included, numbers
+		// within them are not versions on their own
+		auto end = pos;
+		if ((end < text_.size()) && (text_[end] == '-')) {
+			const auto n = read_identifiers(text_, end + 1u, true);
+			if (n > 0u) {
+				m.prerelease = text_.substr(end + 1u, n);
+				end += n + 1u;
+			}
+		}
+		if ((end < text_.size()) && (text_[end] == '+')) {
+			const auto n = read_identifiers(text_, end + 1u, false);
+			if (n > 0u) {
+				m.build = text_.substr(end + 1u, n);
+				end += n + 1u;
+			}
+		}
+		if (opt_.include_prerelease) {
+			pos = end;
+		} else {
+			m.prerelease = {};
+			m.build = {};
+		}
+
+		m.text = text_.substr(start, pos - start);
+		pos_ = end;
+		return true;
+	}
+}
+
+std::vector<coerce_match> coerce_all(std::string_view text, const coerce_options & opt)
+{
+	std::vector<coerce_match> result;
+	coerce_scanner scanner(text, opt);
+	for (coerce_match m; scanner.next(m);)
+		result.push_back(m);
+	return result;
+}
+
+semver coerce(std::string_view text, const coerce_options & opt)
+{
+	coerce_scanner scanner(text, opt);
+	coerce_match m;
+	if (!scanner.next(m))
+		return semver::invalid();
+	return m.to_semver();
+}
+}
+}
@@ -0,0 +1,397 @@
+#include <semver/compressed.hpp>
+#include "detail/semver_parser.hpp"
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <unordered_map>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+namespace
+{
+// Each version starts with a tag byte:
+//
+//   bits 0-1 : how the core is encoded, relative to the preceding version or 0.0.0
+//              at the start of a block:
+//              - patch:  difference of patch numbers
+//              - minor:  difference of minor numbers, patch number
+//              - major:  difference of major numbers, minor and patch number
+//   bit 2    : prerelease follows, the number of identifiers and the identifiers
+//   bit 3    : build metadata follows, index of the dictionary entry
+//   bits 4-7 : with `core_patch`, the difference plus one if it is less than 15,
+//              otherwise 0 and the difference follows
+//
+// All numbers are varints. Prerelease identifiers are numbers shifted left by one bit,
+// or indices of dictionary entries shifted left by one bit with the lowest bit set.
+constexpr unsigned int core_patch = 0u;
+constexpr unsigned int core_minor = 1u;
+constexpr unsigned int core_major = 2u;
+constexpr unsigned int core_mask = 0x03u;
+constexpr unsigned int has_prerelease = 0x04u;
+constexpr unsigned int has_build = 0x08u;
+constexpr unsigned int inline_shift = 4u;
+constexpr std::uint64_t inline_max = 14u;
+
+// numeric identifiers of up to 18 digits fit into an identifier number
+constexpr std::size_t max_numeric_digits = 18u;
+
+void write_varint(std::string & out, std::uint64_t n)
+{
+	while (n >= 0x80u) {
+		out += static_cast<char>((n & 0x7fu) | 0x80u);
+		n >>= 7;
+	}
+	out += static_cast<char>(n);
+}
+
+// The data was written by `write_varint`, it is not checked.
+std::uint64_t read_varint(const std::string & data, std::size_t & offset) noexcept
+{
+	std::uint64_t n = 0u;
+	for (unsigned int shift = 0u;; shift += 7u) {
+		const auto b = static_cast<std::uint8_t>(data[offset++]);
+		n |= static_cast<std::uint64_t>(b & 0x7fu) << shift;
+		if ((b & 0x80u) == 0u)
+			return n;
+	}
+}
+
+// Returns true if the identifier is stored as number: digits without leading zero.
+bool is_number(std::string_view id) noexcept
+{
+	if (id.empty() || (id.size() > max_numeric_digits) || ((id[0] == '0') && (id.size() > 1u)))
+		return false;
+	return std::all_of(begin(id), end(id), [](char c) { return (c >= '0') && (c <= '9'); });
+}
+
+// Appends versions to the data of a list.
+struct compressed_encoder {
+	std::string & data;
+	std::string & dictionary;
+	std::vector<std::uint32_t> & entries;
+
+	// entries by their text, which refers to the versions being encoded
+	std::unordered_map<std::string_view, std::uint64_t> index = {};
+	std::string identifiers = {};
+
+	void encode(const semver & v, const semver & prev)
+	{
+		const auto tag_pos = data.size();
+		data += '\0';
+
+		unsigned int tag = 0u;
+		if (v.major() != prev.major()) {
+			tag = core_major;
+			write_varint(data, v.major() - prev.major());
+			write_varint(data, v.minor());
+			write_varint(data, v.patch());
+		} else if (v.minor() != prev.minor()) {
+			tag = core_minor;
+			write_varint(data, v.minor() - prev.minor());
+			write_varint(data, v.patch());
+		} else {
+			const std::uint64_t delta = v.patch() - prev.patch();
+			tag = core_patch;
+			if (delta <= inline_max) {
+				tag |= static_cast<unsigned int>(delta + 1u) << inline_shift;
+			} else {
+				write_varint(data, delta);
+			}
+		}
+
+		if (!v.prerelease().empty()) {
+			tag |= has_prerelease;
+			identifiers.clear();
+			std::uint64_t count = 0u;
+			std::string_view p = v.prerelease();
+			for (;;) {
+				const auto dot = p.find('.');
+				const auto id = p.substr(0u, dot);
+				if (is_number(id)) {
+					std::uint64_t n = 0u;
+					for (const auto c : id)
+						n = n * 10u + static_cast<std::uint64_t>(c - '0');
+					write_varint(identifiers, n << 1);
+				} else {
+					write_varint(identifiers, (entry(id) << 1) | 1u);
+				}
+				++count;
+				if (dot == std::string_view::npos)
+					break;
+				p.remove_prefix(dot + 1u);
+			}
+			write_varint(data, count);
+			data += identifiers;
+		}
+
+		if (!v.build().empty()) {
+			tag |= has_build;
+			write_varint(data, entry(v.build()));
+		}
+
+		data[tag_pos] = static_cast<char>(tag);
+	}
+
+	// Returns the index of the dictionary entry, adds it if it is new.
+	std::uint64_t entry(std::string_view s)
+	{
+		const auto i = index.find(s);
+		if (i != index.end())
+			return i->second;
+		entries.push_back(static_cast<std::uint32_t>(dictionary.size()));
+		dictionary += s;
+		return index.emplace(s, entries.size() - 1u).first->second;
+	}
+};
+}
+}
+
+compressed_versions::compressed_versions(const std::vector<semver> & versions)
+{
+	auto encoder = detail::compressed_encoder {data_, dictionary_, entries_};
+	semver prev;
+	for (std::size_t i = 0u; i < versions.size(); ++i) {
+		const auto & v = versions[i];
+		if (!v.ok() || ((i > 0u) && (v < prev)))
+			return;
+		if ((i % block_size) == 0u) {
+			if (data_.size() > std::numeric_limits<std::uint32_t>::max())
+				return;
+			blocks_.push_back(static_cast<std::uint32_t>(data_.size()));
+			encoder.encode(v, semver(0, 0, 0));
+		} else {
+			encoder.encode(v, prev);
+		}
+		prev = v;
+	}
+	if ((dictionary_.size() > std::numeric_limits<std::uint32_t>::max())
+		|| (data_.size() > std::numeric_limits<std::uint32_t>::max()))
+		return;
+	if (!entries_.empty())
+		entries_.push_back(static_cast<std::uint32_t>(dictionary_.size()));
+
+	data_.shrink_to_fit();
+	blocks_.shrink_to_fit();
+	dictionary_.shrink_to_fit();
+	entries_.shrink_to_fit();
+	count_ = versions.size();
+	good_ = true;
+}
+
+std::string_view compressed_versions::entry(std::uint64_t i) const noexcept
+{
+	const auto b = entries_[i];
+	return std::string_view(dictionary_).substr(b, entries_[i + 1u] - b);
+}
+
+void compressed_versions::decode(std::size_t & offset, semver & v, bool block_start) const
+{
+	using parser = detail::semver_parser;
+
+	const auto tag = static_cast<std::uint8_t>(data_[offset++]);
+	auto major = block_start ? 0u : v.major();
+	auto minor = block_start ? 0u : v.minor();
+	auto patch = block_start ? 0u : v.patch();
+	switch (tag & detail::core_mask) {
+		case detail::core_major:
+			major += detail::read_varint(data_, offset);
+			minor = detail::read_varint(data_, offset);
+			patch = detail::read_varint(data_, offset);
+			break;
+		case detail::core_minor:
+			minor += detail::read_varint(data_, offset);
+			patch = detail::read_varint(data_, offset);
+			break;
+		default:
+			if ((tag >> detail::inline_shift) != 0u) {
+				patch += (tag >> detail::inline_shift) - 1u;
+			} else {
+				patch += detail::read_varint(data_, offset);
+			}
+			break;
+	}
+	parser::assign_core(v, major, minor, patch);
+
+	auto & prerelease = parser::prerelease(v);
+	prerelease.clear();
+	if (tag & detail::has_prerelease) {
+		const auto count = detail::read_varint(data_, offset);
+		for (std::uint64_t i = 0u; i < count; ++i) {
+			if (i > 0u)
+				prerelease += '.';
+			const auto id = detail::read_varint(data_, offset);
+			if (id & 1u) {
+				prerelease += entry(id >> 1);
+			} else {
+				char buf[semver::max_number_length];
+				const auto r = std::to_chars(buf, buf + sizeof(buf), id >> 1);
+				prerelease.append(buf, r.ptr);
+			}
+		}
+	}
+
+	auto & build = parser::build(v);
+	build.clear();
+	if (tag & detail::has_build)
+		build = entry(detail::read_varint(data_, offset));
+}
+
+compressed_versions::const_iterator::const_iterator(
+	const compressed_versions * list, std::size_t index)
+	: list_(list)
+	, index_(index)
+{
+	if (index_ < list_->count_) {
+		offset_ = list_->blocks_[index_ / block_size];
+		list_->decode(offset_, current_, true);
+	}
+}
+
+compressed_versions::const_iterator & compressed_versions::const_iterator::operator++()
+{
+	if (++index_ < list_->count_)
+		list_->decode(offset_, current_, (index_ % block_size) == 0u);
+	return *this;
+}
+
+compressed_versions::const_iterator compressed_versions::const_iterator::operator++(int)
+{
+	auto tmp = *this;
+	++*this;
+	return tmp;
+}
+
+semver compressed_versions::operator[](std::size_t i) const
+{
+	const auto block = i / block_size;
+	std::size_t offset = blocks_[block];
+	semver v;
+	for (auto k = block * block_size; k <= i; ++k)
+		decode(offset, v, k == block * block_size);
+	return v;
+}
+
+semver compressed_versions::block_start(std::size_t block) const
+{
+	std::size_t offset = blocks_[block];
+	semver v;
+	decode(offset, v, true);
+	return v;
+}
+
+std::size_t compressed_versions::block_end(std::size_t block) const noexcept
+{
+	return std::min(count_, (block + 1u) * block_size);
+}
+
+std::pair<std::size_t, std::size_t> compressed_versions::candidates(const range & r) const
+{
+	// versions are sorted, all versions less than the range are at the beginning,
+	// all greater than the range at the end. The first candidate block is the last
+	// one starting below the range.
+	std::size_t lo = 0u;
+	std::size_t hi = blocks_.size();
+	while (lo < hi) {
+		const auto mid = lo + (hi - lo) / 2u;
+		if (r.ltr(block_start(mid)))
+			lo = mid + 1u;
+		else
+			hi = mid;
+	}
+	const auto first = (lo > 0u) ? lo - 1u : 0u;
+	hi = blocks_.size();
+	while (lo < hi) {
+		const auto mid = lo + (hi - lo) / 2u;
+		if (r.gtr(block_start(mid)))
+			hi = mid;
+		else
+			lo = mid + 1u;
+	}
+	return {first, lo};
+}
+
+semver compressed_versions::max_satisfying(const range & r) const
+{
+	if (!good_ || !r.ok())
+		return {};
+
+	const auto [first, last] = candidates(r);
+	semver v;
+	semver result;
+	for (auto block = last; block > first; --block) {
+		const auto b = block - 1u;
+		std::size_t offset = blocks_[b];
+		bool found = false;
+		for (auto i = b * block_size; i < block_end(b); ++i) {
+			decode(offset, v, i == b * block_size);
+			if (r.gtr(v))
+				break;
+			if (r.satisfies(v) && (!found || (result < v))) {
+				result = v;
+				found = true;
+			}
+		}
+		if (!found)
+			continue;
+
+		// versions of equal precedence may start in preceding blocks
+		for (auto k = b; (k > 0u) && (block_start(k) == result); --k) {
+			offset = blocks_[k - 1u];
+			for (auto i = (k - 1u) * block_size; i < block_end(k - 1u); ++i) {
+				decode(offset, v, i == (k - 1u) * block_size);
+				if (v == result) {
+					result = v;
+					break;
+				}
+			}
+		}
+		return result;
+	}
+	return {};
+}
+
+semver compressed_versions::min_satisfying(const range & r) const
+{
+	if (!good_ || !r.ok())
+		return {};
+
+	const auto [first, last] = candidates(r);
+	semver v;
+	for (auto b = first; b < last; ++b) {
+		std::size_t offset = blocks_[b];
+		for (auto i = b * block_size; i < block_end(b); ++i) {
+			decode(offset, v, i == b * block_size);
+			if (r.gtr(v))
+				return {};
+			if (r.satisfies(v))
+				return v;
+		}
+	}
+	return {};
+}
+
+std::size_t compressed_versions::memory_usage() const noexcept
+{
+	return sizeof(*this) + data_.capacity() + blocks_.capacity() * sizeof(std::uint32_t)
+		+ dictionary_.capacity() + entries_.capacity() * sizeof(std::uint32_t);
+}
+
+std::size_t compressed_versions::memory_usage(const std::vector<semver> & versions) noexcept
+{
+	// strings longer than the capacity of an empty string are allocated
+	const auto capacity = std::string().capacity();
+	std::size_t n = sizeof(versions) + versions.capacity() * sizeof(semver);
+	for (const auto & v : versions) {
+		for (const auto * s : {&v.prerelease(), &v.build()}) {
+			if (s->capacity() > capacity)
+				n += s->capacity() + 1u;
+		}
+	}
+	return n;
+}
+}
+}
@@ -0,0 +1,118 @@
+#ifndef SEMVER_DETAIL_PRECEDENCE_HPP
+#define SEMVER_DETAIL_PRECEDENCE_HPP
+
+#include <semver/semver.hpp>
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+// Returns true if the prerelease `p1` has a lower precedence than `p2`. Both must be
+// valid prereleases, no prerelease (empty) has a higher precedence than any other.
+inline bool prerelease_less(std::string_view p1, std::string_view p2) noexcept
+{
+	// if one has a prerelease the other not, the one with is smaller
+	if (!p1.empty() && p2.empty())
+		return true;
+	if (p1.empty())
+		return false;
+
+	// compare fields of prerelease individually, separated by '.'
+	// rules from semver.org, literally or shortened:
+	//
+	//   - pure numerically are compared numerically
+	//   - alphanumeric are compared lexically
+	//   - pure numerically has always lower precedence than alphanumerically
+	//   - larger set of fields has a higher precedence than the smaller set, if all of
+	//     preceeding identifiers are equal, example:
+	//     1.0.0-alpha < 1.0.0-alpha.1 < 1.0.0-alpha.beta < 1.0.0-beta < 1.0.0-beta.2
+	//     < 1.0.0-beta.11 < 1.0.0-rc.1 < 1.0.0
+	//
+	const auto is_numeric = [](std::string_view s) {
+		return std::all_of(begin(s), end(s), [](char c) { return (c >= '0') && (c <= '9'); });
+	};
+
+	for (;;) {
+		const auto c1e = p1.find('.');
+		const auto c2e = p2.find('.');
+		const auto f1 = p1.substr(0, c1e);
+		const auto f2 = p2.substr(0, c2e);
+
+		// numerical vs alphanumerical fields? alphanumerical alwasys wins
+		const bool c1num = is_numeric(f1);
+		const bool c2num = is_numeric(f2);
+		if (c1num && !c2num)
+			return true;
+		if (!c1num && c2num)
+			return false;
+
+		if (c1num && c2num) {
+			// pure numerical comparison
+
+			semver::number_type p1n = 0u;
+			semver::number_type p2n = 0u;
+
+			// we ignore the return value because it was already tested to be numerical only
+			std::from_chars(f1.data(), f1.data() + f1.size(), p1n);
+			std::from_chars(f2.data(), f2.data() + f2.size(), p2n);
+
+			if (p1n < p2n)
+				return true;
+			if (p1n > p2n)
+				return false;
+		} else {
+			// alphanumerical comparison
+
+			const auto rc = f1.compare(f2);
+			if (rc < 0)
+				return true;
+			if (rc > 0)
+				return false;
+		}
+
+		// compare number of fields, unil now all fields were the same, the one with
+		// more fields is the higher version
+		if ((c1e != std::string_view::npos) && (c2e == std::string_view::npos))
+			return false; // p1 has more fields
+		if ((c1e == std::string_view::npos) && (c2e != std::string_view::npos))
+			return true; // p2 has more fields
+		if ((c1e == std::string_view::npos) && (c2e == std::string_view::npos))
+			return false; // both exhausted
+
+		// all were the same until now, on to the next field
+		p1.remove_prefix(c1e + 1u);
+		p2.remove_prefix(c2e + 1u);
+	}
+}
+
+// Returns true if `v1` has a lower precedence than `v2`. Works for any type
+// providing the accessors of `semver`, e.g. views of encoded versions.
+template <typename V1, typename V2> bool precedes(const V1 & v1, const V2 & v2) noexcept
+{
+	// major, minor and patch are first priority to compare in descending order. if one
+	// of them is different, it is already decided.
+	if (v1.major() != v2.major())
+		return v1.major() < v2.major();
+	if (v1.minor() != v2.minor())
+		return v1.minor() < v2.minor();
+	if (v1.patch() != v2.patch())
+		return v1.patch() < v2.patch();
+	return prerelease_less(v1.prerelease(), v2.prerelease());
+}
+
+template <typename V1, typename V2> bool same_precedence(const V1 & v1, const V2 & v2) noexcept
+{
+	return (v1.major() == v2.major()) && (v1.minor() == v2.minor())
+		&& (v1.patch() == v2.patch())
+		&& (std::string_view(v1.prerelease()) == std::string_view(v2.prerelease()));
+}
+}
+}
+}
+
+#endif
@@ -4,7 +4,9 @@
 #include "semver_parser.hpp"
 #include <semver/semver.hpp>
 #include <algorithm>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <cassert>
 
 namespace semver
@@ -16,7 +18,7 @@ namespace detail
 class range_lexer final
 {
 public:
-	using string_type = std::string;
+	using string_type = std::string_view;
 
 	enum class token {
 		partial,
@@ -31,6 +33,9 @@ public:
 
 	// structure to hold scanned parts, not all are strictly necessary but
 	// caching them makes it easier to process the result.
+	//
+	// All texts are views into the data the lexer was constructed with,
+	// they are valid as long as the data is.
 	struct parts {
 		string_type token = {}; // full token
 
@@ -44,9 +49,19 @@ public:
 		string_type patch = {};
 		string_type prerelease = {};
 		string_type build = {};
+
+		// wildcards (`*`, `x` or `X`) are not normalized within the text
+		bool major_wildcard = false;
+		bool minor_wildcard = false;
+		bool patch_wildcard = false;
+
+		// numerical values, zero if the part is empty or a wildcard
+		semver::number_type major_number = 0u;
+		semver::number_type minor_number = 0u;
+		semver::number_type patch_number = 0u;
 	};
 
-	range_lexer(const std::string & s)
+	range_lexer(string_type s)
 		: data_(s)
 	{
 		cursor_ = data_.data();
@@ -93,7 +108,7 @@ public:
 		return token::eof;
 	}
 
-	const string_type & data() const noexcept { return data_; }
+	string_type data() const noexcept { return data_; }
 
 	const parts & text() noexcept { return parts_; }
 
@@ -106,37 +121,23 @@ private:
 	const char_type * error_ = nullptr;
 
 	parts parts_;
-	std::string data_;
-
-	void patch(char c) noexcept
-	{
-		assert(cursor_ >= data_.data());
-		assert(cursor_ < data_.data() + data_.size());
-		char_type * p = const_cast<char_type *>(cursor_); // we know what we are doing
-		*p = c;
-	}
+	string_type data_;
 
 	void clear() noexcept { parts_ = {}; }
 
-	void store()
+	void store() noexcept
 	{
 		store(parts_.token, start_);
 		store(parts_.version, start_ + parts_.op.size());
 	}
 
-	void store(string_type & s, const char_type * start)
+	void store(string_type & s, const char_type * start) noexcept
 	{
 		const auto d = std::distance(start, cursor_);
 		assert(d >= 0);
 		s = string_type(start, static_cast<std::size_t>(d));
 	}
 
-	bool is_numerical(const string_type & s) const
-	{
-		return std::find_if_not(begin(s), end(s), [](const auto c) { return isdigit(c); })
-			== end(s);
-	}
-
 	void error() noexcept { error_ = cursor_; }
 	void advance(int n) noexcept { cursor_ += std::min(n, static_cast<int>(last_ - cursor_)); }
 
@@ -179,7 +180,7 @@ private:
 	bool is_op() const noexcept { return is_lt() || is_le() || is_gt() || is_ge() || is_eq(); }
 	bool is_logical_or() const noexcept { return (*cursor_ == '|') && (peek() == '|'); }
 
-	token lex_caret_partial()
+	token lex_caret_partial() noexcept
 	{
 		scan_op();
 		scan_partial();
@@ -187,7 +188,7 @@ private:
 		return (!error_) ? token::caret_partial : token::error;
 	}
 
-	token lex_tilde_partial()
+	token lex_tilde_partial() noexcept
 	{
 		scan_op();
 		scan_partial();
@@ -195,7 +196,7 @@ private:
 		return (!error_) ? token::tilde_partial : token::error;
 	}
 
-	token lex_op_partial()
+	token lex_op_partial() noexcept
 	{
 		scan_op();
 		scan_partial();
@@ -203,14 +204,14 @@ private:
 		return (!error_) ? token::op_partial : token::error;
 	}
 
-	token lex_partial()
+	token lex_partial() noexcept
 	{
 		scan_partial();
 		store();
 		return (!error_) ? token::partial : token::error;
 	}
 
-	void scan_op()
+	void scan_op() noexcept
 	{
 		const char_type * p = cursor_;
 		if (is_eq() || is_lt() || is_gt() || is_tilde() || is_caret())
@@ -220,42 +221,42 @@ private:
 		store(parts_.op, p);
 	}
 
-	void scan_major()
+	void scan_major() noexcept
 	{
 		const char_type * p = cursor_;
-		scan_partial_version();
+		parts_.major_wildcard = scan_partial_version(parts_.major_number);
 		store(parts_.major, p);
 	}
 
-	void scan_minor()
+	void scan_minor() noexcept
 	{
 		const char_type * p = cursor_;
-		scan_partial_version();
+		parts_.minor_wildcard = scan_partial_version(parts_.minor_number);
 		store(parts_.minor, p);
 	}
 
-	void scan_patch()
+	void scan_patch() noexcept
 	{
 		const char_type * p = cursor_;
-		scan_partial_version();
+		parts_.patch_wildcard = scan_partial_version(parts_.patch_number);
 		store(parts_.patch, p);
 	}
 
-	void scan_prerelease()
+	void scan_prerelease() noexcept
 	{
 		const char_type * p = cursor_;
 		scan_dot_separated_identifier();
 		store(parts_.prerelease, p);
 	}
 
-	void scan_build()
+	void scan_build() noexcept
 	{
 		const char_type * p = cursor_;
 		scan_dot_separated_identifier();
 		store(parts_.build, p);
 	}
 
-	void scan_partial()
+	void scan_partial() noexcept
 	{
 		parts_.full_version = false;
 
@@ -273,8 +274,8 @@ private:
 
 		scan_patch();
 
-		parts_.full_version = is_numerical(parts_.major) && is_numerical(parts_.minor)
-			&& is_numerical(parts_.patch);
+		parts_.full_version
+			= !parts_.major_wildcard && !parts_.minor_wildcard && !parts_.patch_wildcard;
 
 		if (is_dash()) {
 			advance(1);
@@ -311,78 +312,95 @@ private:
 			advance(1);
 	}
 
-	void scan_partial_version() noexcept
+	// returns true if the scanned part is a wildcard, the numerical value
+	// is accumulated while scanning, overflows are errors.
+	bool scan_partial_version(semver::number_type & n) noexcept
 	{
-		if (is_x()) {
-			patch('*'); // normalize wildcards to '*'
+		constexpr auto max = std::numeric_limits<semver::number_type>::max();
+
+		n = 0u;
+		if (is_x() || is_star()) {
 			advance(1);
-			return;
-		}
-		if (is_star()) {
-			advance(1);
-			return;
+			return true;
 		}
 		if (is_zero()) {
 			advance(1);
-			return;
+			return false;
 		}
 		if (is_positive_digit()) {
-			advance(1);
-			while (is_digit())
+			while (is_digit()) {
+				const semver::number_type d = *cursor_ - '0';
+				if (n > (max - d) / 10u) {
+					error();
+					return false;
+				}
+				n = n * 10u + d;
 				advance(1);
-			return;
+			}
+			return false;
 		}
 		error();
+		return false;
 	}
 };
 
-inline semver lower_bound(const range_lexer::parts & p)
+// Bounds of a comparator without constructing a `semver`, the prerelease refers
+// to the text of the range or to a literal. Build metadata is not part of a bound.
+inline version_tuple lower_bound_view(const range_lexer::parts & p) noexcept
 {
-	if (p.major.empty() || p.major == "*")
-		return semver::min();
-
-	const auto major = semver_parser::ston(p.major);
+	if (p.major.empty() || p.major_wildcard)
+		return {0u, 0u, 0u};
 
-	if (p.minor.empty() || p.minor == "*")
-		return semver(major, 0, 0);
+	if (p.minor.empty() || p.minor_wildcard)
+		return {p.major_number, 0u, 0u};
 
-	const auto minor = semver_parser::ston(p.minor);
+	if (p.patch.empty() || p.patch_wildcard)
+		return {p.major_number, p.minor_number, 0u};
 
-	if (p.patch.empty() || p.patch == "*")
-		return semver(major, minor, 0);
-
-	return semver(p.token.substr(
-		p.op.size(), p.token.size() - p.op.size() - p.build.size() + 1)); // cut op and build
+	return {p.major_number, p.minor_number, p.patch_number, p.prerelease};
 }
 
-inline semver upper_bound(const range_lexer::parts & p)
+inline version_tuple upper_bound_view(const range_lexer::parts & p) noexcept
 {
-	if (p.major.empty() || p.major == "*")
-		return semver::max();
+	constexpr auto max = std::numeric_limits<semver::number_type>::max();
 
-	const auto major = semver_parser::ston(p.major);
+	if (p.major.empty() || p.major_wildcard)
+		return {max, max, max};
 
-	if (p.op == "^" && p.major != "0")
-		return semver(major + 1u, 0, 0, "0");
+	const auto major = p.major_number;
 
-	if (p.minor.empty() || p.minor == "*")
-		return semver(major + 1u, 0, 0, "0");
+	if (p.op == "^" && major != 0u)
+		return {major + 1u, 0u, 0u, "0"};
 
-	const auto minor = semver_parser::ston(p.minor);
+	if (p.minor.empty() || p.minor_wildcard)
+		return {major + 1u, 0u, 0u, "0"};
 
-	if (p.op == "^" && p.minor != "0")
-		return semver(major, minor + 1u, 0, "0");
+	const auto minor = p.minor_number;
 
-	if (p.patch.empty() || p.patch == "*" || p.op == "~")
-		return semver(major, minor + 1u, 0, "0");
+	if (p.op == "^" && minor != 0u)
+		return {major, minor + 1u, 0u, "0"};
 
-	const auto patch = semver_parser::ston(p.patch);
+	if (p.patch.empty() || p.patch_wildcard || p.op == "~")
+		return {major, minor + 1u, 0u, "0"};
 
-	if (p.op == "^" && p.patch != "0")
-		return semver(major, minor, patch + 1u, "0");
+	const auto patch = p.patch_number;
 
-	return semver(p.token.substr(
-		p.op.size(), p.token.size() - p.op.size() - p.build.size() + 1)); // cut op and build
+	if (p.op == "^" && patch != 0u)
+		return {major, minor, patch + 1u, "0"};
+
+	return {major, minor, patch, p.prerelease};
+}
+
+inline semver lower_bound(const range_lexer::parts & p)
+{
+	const auto v = lower_bound_view(p);
+	return semver_parser::create(v.major(), v.minor(), v.patch(), v.prerelease());
+}
+
+inline semver upper_bound(const range_lexer::parts & p)
+{
+	const auto v = upper_bound_view(p);
+	return semver_parser::create(v.major(), v.minor(), v.patch(), v.prerelease());
 }
 }
 }
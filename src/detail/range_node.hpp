@@ -1,12 +1,14 @@
 #ifndef SEMVER_DETAIL_RANGE_NODE_HPP
 #define SEMVER_DETAIL_RANGE_NODE_HPP
 
+#include "precedence.hpp"
 #include <semver/semver.hpp>
 #include <algorithm>
 #include <limits>
 #include <optional>
 #include <ostream>
 #include <memory>
+#include <string_view>
 #include <vector>
 #include <cassert>
 
@@ -74,6 +76,44 @@ inline semver predecessor(const semver & v)
 	return semver(major, minor, patch);
 }
 
+// Order of the leafs of a range, by version, then by operator. Versions of equal
+// precedence with different texts (numeric identifiers with leading zeros) are
+// ordered by their prerelease texts, this makes it a strict weak ordering.
+template <typename V1, typename V2, typename Op>
+bool less_leaf(const V1 & v1, Op op1, const V2 & v2, Op op2) noexcept
+{
+	if (precedes(v1, v2))
+		return true;
+	if (precedes(v2, v1))
+		return false;
+	const auto rc
+		= std::string_view(v1.prerelease()).compare(std::string_view(v2.prerelease()));
+	if (rc != 0)
+		return rc < 0;
+	return op1 < op2;
+}
+
+// Order of the alternatives of a range for sorting, simple ones first. Alternatives
+// are sequences of the leafs, `size()`, the versions by `operator[]` and the
+// operators by `op()`, a single leaf is a sequence of one leaf:
+//
+//   - leafs precede `and` nodes, `and` nodes are ordered by their size
+//   - alternatives of the same size are ordered lexicographically by their leafs
+//
+// This is the order of the AST of a range, whether it is built as nodes or flat.
+template <typename A, typename B> bool less_alternative(const A & a, const B & b) noexcept
+{
+	if (a.size() != b.size())
+		return a.size() < b.size();
+	for (std::size_t i = 0u; i < a.size(); ++i) {
+		if (less_leaf(a[i], a.op(i), b[i], b.op(i)))
+			return true;
+		if (less_leaf(b[i], b.op(i), a[i], a.op(i)))
+			return false;
+	}
+	return false;
+}
+
 class node final
 {
 public:
@@ -107,6 +147,23 @@ public:
 		return node(type::op_and, std::move(v));
 	}
 
+	// Creates an `and` node, children of `and` nodes within `v` are moved into
+	// the new node instead, the result therefore contains only leafs.
+	static node create_and_of_leafs(std::vector<std::unique_ptr<node>> && v)
+	{
+		std::vector<std::unique_ptr<node>> leafs;
+		leafs.reserve(v.size());
+		for (auto & n : v) {
+			if (n->get_type() == type::op_and) {
+				for (auto & c : n->nodes_)
+					leafs.push_back(std::move(c));
+			} else {
+				leafs.push_back(std::move(n));
+			}
+		}
+		return node(type::op_and, std::move(leafs));
+	}
+
 	static node create_or(node && first, node && second)
 	{
 		return create_or(std::make_unique<node>(std::move(first)),
@@ -122,39 +179,75 @@ public:
 		return node(type::op_or, std::move(v));
 	}
 
+	// Returns a deep copy of the node, children keep their order.
+	std::unique_ptr<node> clone() const
+	{
+		if (is_leaf())
+			return std::make_unique<node>(node(type_, *version_));
+		auto result = std::make_unique<node>(node(type_, std::vector<std::unique_ptr<node>> {}));
+		result->nodes_.reserve(nodes_.size());
+		for (const auto & n : nodes_)
+			result->nodes_.push_back(n->clone());
+		return result;
+	}
+
+	// Creates an `and` node of leafs which are sorted already.
+	static node create_and_of_sorted_leafs(std::vector<std::unique_ptr<node>> && v)
+	{
+		node n(type::op_and, std::vector<std::unique_ptr<node>> {});
+		n.nodes_ = std::move(v);
+		return n;
+	}
+
+	// Creates a leaf, `t` is a comparison.
+	static node create_leaf(type t, const semver & s)
+	{
+		assert((t != type::op_and) && (t != type::op_or));
+		return {t, s};
+	}
+
 	static node create_eq(const semver & s) { return {type::op_eq, s}; }
 	static node create_lt(const semver & s) { return {type::op_lt, s}; }
 	static node create_le(const semver & s) { return {type::op_le, s}; }
 	static node create_gt(const semver & s) { return {type::op_gt, s}; }
 	static node create_ge(const semver & s) { return {type::op_ge, s}; }
 
-	bool eval(const semver & v) const noexcept
+	// Evaluates the node for a version, `V` is `semver` or any type providing
+	// the same accessors, e.g. `semver_view`.
+	template <typename V> bool eval(const V & v) const noexcept
 	{
+		return eval(v, [] {});
+	}
+
+	// Evaluates the node, calls `visit()` for each evaluated node.
+	template <typename V, typename Visit> bool eval(const V & v, Visit visit) const noexcept
+	{
+		visit();
 		switch (type_) {
 			case type::op_and:
 				// shortcut behavior
 				for (const auto & n : nodes_)
-					if (!n->eval(v))
+					if (!n->eval(v, visit))
 						return false;
 				return true;
 
 			case type::op_or:
 				// shortcut behavior
 				for (const auto & n : nodes_)
-					if (n->eval(v))
+					if (n->eval(v, visit))
 						return true;
 				return false;
 
 			case type::op_eq:
-				return v == *version_;
+				return same_precedence(v, *version_);
 			case type::op_lt:
-				return v < *version_;
+				return precedes(v, *version_);
 			case type::op_le:
-				return v <= *version_;
+				return !precedes(*version_, v);
 			case type::op_gt:
-				return v > *version_;
+				return precedes(*version_, v);
 			case type::op_ge:
-				return v >= *version_;
+				return !precedes(v, *version_);
 		}
 		return false;
 	}
@@ -199,24 +292,11 @@ public:
 	friend bool operator!=(const node & a, const node & b) { return !(a == b); }
 
 	// This is not an operator, because it has a special semantic in regards
-	// of comparing elements of non-leaf nodes. This function is for soring nodes.
+	// of comparing elements of non-leaf nodes. This function is for soring nodes,
+	// see `less_alternative`.
 	static bool less(const node & a, const node & b)
 	{
-		if (a.is_leaf() && b.is_leaf())
-			return *a.version_ < *b.version_;
-		if (a.is_leaf() && !b.is_leaf())
-			return true;
-		if (!a.is_leaf() && b.is_leaf())
-			return false;
-		if (!a.is_leaf() && !b.is_leaf()) {
-			if (a.nodes_.size() != b.nodes_.size())
-				return false;
-
-			// less if one element is less than the corresponding element
-			return compare_seq_if(begin(a.nodes_), end(a.nodes_), begin(b.nodes_),
-				[](const auto & x, const auto & y) { return node::less(*x, *y); });
-		}
-		return false;
+		return less_alternative(leaf_versions {a}, leaf_versions {b});
 	}
 
 private:
@@ -238,19 +318,26 @@ private:
 			[](const auto & a, const auto & b) { return node::less(*a, *b); });
 	}
 
-	template <typename Iterator, typename Cmp>
-	static bool compare_seq_if(Iterator first_1, Iterator last_1, Iterator first_2, Cmp cmp)
-	{
-		for (; first_1 != last_1; ++first_1, ++first_2)
-			if (cmp(*first_1, *first_2))
-				return true;
-		return false;
-	}
+	// versions of a leaf, or of the leafs of an `and` node
+	struct leaf_versions {
+		const node & n;
+
+		std::size_t size() const noexcept { return n.is_leaf() ? 1u : n.nodes_.size(); }
 
-	friend void collect_leafs_and_andnodes(std::vector<std::unique_ptr<node>> &, node &);
+		const semver & operator[](std::size_t i) const noexcept
+		{
+			assert(n.is_leaf() || n.nodes_[i]->is_leaf());
+			return n.is_leaf() ? *n.version_ : *n.nodes_[i]->version_;
+		}
+
+		type op(std::size_t i) const noexcept
+		{
+			return n.is_leaf() ? n.type_ : n.nodes_[i]->type_;
+		}
+	};
 };
 
-inline std::string to_string(const node::type t)
+inline std::string_view op_string(const node::type t) noexcept
 {
 	switch (t) {
 		case node::type::op_and:
@@ -271,27 +358,54 @@ inline std::string to_string(const node::type t)
 	return {};
 }
 
+inline std::string to_string(const node::type t)
+{
+	return std::string(op_string(t));
+}
+
 inline std::ostream & operator<<(std::ostream & os, const node::type t)
 {
 	return os << to_string(t);
 }
 
-inline std::string to_string(const node & n)
+// Writes the formatted node in pieces to `write(const char *, std::size_t)`.
+template <typename Write> void format_node(const node & n, Write && write)
 {
-	if (n.is_leaf())
-		return to_string(n.get_type()) + to_string(n.get_version());
+	if (n.is_leaf()) {
+		const auto op = op_string(n.get_type());
+		write(op.data(), op.size());
+		format_semver(n.get_version(), write);
+		return;
+	}
 
-	std::string s;
 	bool first = true;
 	for (const auto & c : n) {
 		if (first) {
 			first = false;
 		} else {
-			s += ' ';
+			write(" ", 1u);
 		}
 
-		s += to_string(*c);
+		format_node(*c, write);
 	}
+}
+
+inline std::size_t formatted_size(const node & n) noexcept
+{
+	if (n.is_leaf())
+		return op_string(n.get_type()).size() + ::semver::formatted_size(n.get_version());
+
+	std::size_t size = 0u;
+	for (const auto & c : n)
+		size += formatted_size(*c) + 1u;
+	return (size > 0u) ? size - 1u : 0u;
+}
+
+inline std::string to_string(const node & n)
+{
+	std::string s;
+	s.reserve(formatted_size(n));
+	format_node(n, [&s](const char * p, std::size_t size) { s.append(p, size); });
 	return s;
 }
 
@@ -341,21 +455,6 @@ inline semver upper_bound(const node & n)
 	}
 	return {};
 }
-
-inline void collect_leafs_and_andnodes(std::vector<std::unique_ptr<node>> & v, node & n)
-{
-	assert(n.get_type() == node::type::op_or);
-
-	for (auto && p : n.nodes_) {
-		if (p->get_type() == node::type::op_or) {
-			collect_leafs_and_andnodes(v, *p);
-		} else if (p->get_type() == node::type::op_and) {
-			v.push_back(std::move(p));
-		} else {
-			v.push_back(std::move(p));
-		}
-	}
-}
 }
 }
 }
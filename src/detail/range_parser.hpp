@@ -3,8 +3,14 @@
 
 #include "range_lexer.hpp"
 #include "range_node.hpp"
+#include "semver_parser.hpp"
 #include <semver/semver.hpp>
+#include <semver/range.hpp>
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 namespace semver
@@ -13,229 +19,346 @@ inline namespace v1
 {
 namespace detail
 {
-inline std::string trim(std::string s)
+inline std::string_view trim(std::string_view s) noexcept
 {
 	const auto b = s.find_first_not_of(" ");
 	const auto e = s.find_last_not_of(" ");
 
-	return (b != std::string::npos) ? s.substr(b, e - b + 1) : "";
+	return (b != std::string_view::npos) ? s.substr(b, e - b + 1) : std::string_view {};
 }
 
-class range_parser final
+// Sorts the `or` connected nodes of a range, simple ones first.
+inline void sort_alternatives(std::vector<std::unique_ptr<node>> & nodes)
 {
-private:
-	using char_type = std::string::value_type;
+	std::sort(begin(nodes), end(nodes),
+		[](const auto & a, const auto & b) { return node::less(*a, *b); });
+}
 
-public:
-	range_parser(const std::string & s)
-		: lex_(trim(s))
-	{
-		parse_range_set();
+// Result of scanning a range, see `scan_range`.
+enum class range_syntax { ok, error, limit_exceeded };
+
+// Scans a range, this is the grammar of ranges. The comparators are reported to the
+// sink in the order of the text, see `range_builder`:
+//
+//   - `empty()`: an empty alternative
+//   - `hyphen(first, last)`: the partials of a hyphen range
+//   - `partial(t, parts)`: a caret, tilde, op or plain partial
+//   - `clause_end(n)`: end of an alternative of `n` comparators, `n` is 1 for empty
+//     alternatives and hyphen ranges
+//
+// The sink may have seen a part of the range if it is not ok. Scanning does not
+// allocate, only the sink may.
+template <typename Sink>
+range_syntax scan_range(std::string_view s, const range_limits & limits, Sink & sink)
+{
+	using token = range_lexer::token;
+
+	if (s.size() > limits.max_length)
+		return range_syntax::limit_exceeded;
+
+	auto lex = range_lexer(trim(s));
+	auto current = lex.scan();
+	auto current_text = lex.text();
+	auto next = lex.scan();
+	auto next_text = lex.text();
+	const auto advance = [&] {
+		current = next;
+		current_text = next_text;
+		next = lex.scan();
+		next_text = lex.text();
+	};
+
+	for (std::size_t clauses = 1u;; ++clauses) {
+		if ((current == token::eof) || (current == token::logical_or)) {
+			sink.empty();
+			sink.clause_end(1u);
+		} else if ((current == token::partial) && (next == token::dash)) {
+			const auto first = current_text;
+			advance(); // partial
+			advance(); // dash
+			if (current != token::partial)
+				return range_syntax::error;
+			sink.hyphen(first, current_text);
+			sink.clause_end(1u);
+			advance();
+		} else {
+			std::size_t comparators = 0u;
+			while ((current != token::eof) && (current != token::logical_or)) {
+				if (++comparators > limits.max_comparators)
+					return range_syntax::limit_exceeded;
+				if ((current != token::caret_partial) && (current != token::tilde_partial)
+					&& (current != token::op_partial) && (current != token::partial))
+					return range_syntax::error;
+				sink.partial(current, current_text);
+				advance();
+			}
+			sink.clause_end(comparators);
+		}
 
-		assert(ast_.size() <= 1);
-		if (!ast_.empty())
-			flatten_ast();
+		if (current != token::logical_or)
+			break;
+		if (clauses >= limits.max_clauses)
+			return range_syntax::limit_exceeded;
+		advance(); // logical-or
 	}
+	return (current != token::error) ? range_syntax::ok : range_syntax::error;
+}
 
-	bool ok() const noexcept { return good_; }
+// Checks the syntax of a range without building the AST and without allocating.
+// The grammar is the one of the parser, the result is the same.
+inline bool check_range_syntax(std::string_view s, const range_limits & limits = {}) noexcept
+{
+	struct ignore {
+		void empty() noexcept { }
+		void hyphen(const range_lexer::parts &, const range_lexer::parts &) noexcept { }
+		void partial(range_lexer::token, const range_lexer::parts &) noexcept { }
+		void clause_end(std::size_t) noexcept { }
+	} sink;
+	return scan_range(s, limits, sink) == range_syntax::ok;
+}
 
-	std::vector<std::unique_ptr<node>> && ast()
+// Counts an upper bound of the sizes of a range while scanning, to reserve the
+// containers of a `range_builder`: every comparator is at most two leafs.
+struct range_size {
+	std::size_t leafs = 0u;
+	std::size_t alternatives = 0u;
+
+	void empty() noexcept { ++leafs; }
+	void hyphen(const range_lexer::parts &, const range_lexer::parts &) noexcept { leafs += 2u; }
+	void partial(range_lexer::token, const range_lexer::parts &) noexcept { leafs += 2u; }
+	void clause_end(std::size_t) noexcept { ++alternatives; }
+};
+
+// Leaf of a range being built, the prerelease refers to the text of the range or
+// to a literal.
+struct range_leaf {
+	node::type op;
+	version_tuple version;
+};
+
+// Parts of a complete version, as if `op` and the version were scanned from text.
+// Only the presence of the texts of the numbers matters, not their contents.
+inline range_lexer::parts parts_of(const semver & v, std::string_view op) noexcept
+{
+	range_lexer::parts p;
+	p.full_version = true;
+	p.op = op;
+	p.major = "0";
+	p.minor = "0";
+	p.patch = "0";
+	p.prerelease = v.prerelease();
+	p.major_number = v.major();
+	p.minor_number = v.minor();
+	p.patch_number = v.patch();
+	return p;
+}
+
+// Builds a range as flat lists of leafs, reported by `scan_range` or by the
+// builders of `range`. These are the semantics of the grammar: the leafs of each
+// comparator, and the order of the leafs and alternatives of the AST.
+//
+// An alternative of one leaf is a leaf of the AST, longer ones are `and` nodes
+// of leafs. The leafs of an alternative are sorted by `less_leaf`, the alternatives
+// by `less_alternative`, both with `std::sort`.
+template <typename Allocator = std::allocator<range_leaf>> class range_builder final
+{
+public:
+	struct alternative {
+		std::size_t begin;
+		std::size_t end;
+	};
+
+	using leaf_list = std::vector<range_leaf, Allocator>;
+	using alternative_list = std::vector<alternative,
+		typename std::allocator_traits<Allocator>::template rebind_alloc<alternative>>;
+
+	explicit range_builder(const Allocator & alloc = {})
+		: leafs_(alloc)
+		, alternatives_(typename alternative_list::allocator_type(alloc))
 	{
-		good_ = false;
-		return std::move(ast_);
 	}
 
-private:
-	using token = ::semver::v1::detail::range_lexer::token;
-
-	detail::range_lexer lex_;
-	detail::range_lexer::token token_ = detail::range_lexer::token::eof;
-	detail::range_lexer::token next_ = detail::range_lexer::token::eof;
-	detail::range_lexer::parts token_text_ = {};
-	detail::range_lexer::parts next_text_ = {};
+	void reserve(std::size_t leafs, std::size_t alternatives)
+	{
+		leafs_.reserve(leafs);
+		alternatives_.reserve(alternatives);
+	}
 
-	bool good_ = false;
-	std::vector<std::unique_ptr<node>> ast_;
+	// an empty alternative matches everything
+	void empty() { leaf(node::type::op_ge, {0u, 0u, 0u}); }
 
-	void flatten_ast()
+	void hyphen(const range_lexer::parts & first, const range_lexer::parts & last)
 	{
-		if (ast_back()->is_leaf())
+		// according to the examples provided here: https://github.com/npm/node-semver#versions,
+		// use lower_bound/le if it was a complete partial, upper_bound/lt otherwise
+		auto l = lower_bound_view(first);
+		auto u = last.full_version ? lower_bound_view(last) : upper_bound_view(last);
+		if (same_precedence(l, u)) {
+			leaf(node::type::op_eq, l);
 			return;
+		}
+		if (precedes(u, l))
+			std::swap(l, u);
+		leaf(node::type::op_ge, l);
+		leaf(last.full_version ? node::type::op_le : node::type::op_lt, u);
+		sort_leafs(leafs_.size() - 2u);
+	}
 
-		if (ast_back()->get_type() == node::type::op_and)
+	void partial(range_lexer::token t, const range_lexer::parts & p)
+	{
+		using token = range_lexer::token;
+
+		if (t == token::op_partial) {
+			const auto v = lower_bound_view(p);
+			if (p.op == "<")
+				leaf(node::type::op_lt, v);
+			if (p.op == "<=")
+				leaf(node::type::op_le, v);
+			if (p.op == ">")
+				leaf(node::type::op_gt, v);
+			if (p.op == ">=")
+				leaf(node::type::op_ge, v);
+			if (p.op == "=")
+				leaf(node::type::op_eq, v);
 			return;
+		}
 
-		assert(ast_back()->get_type() == node::type::op_or);
-
-		// transform AST into a list of `or` connected nodes, simple ones frist.
-		// this makes the structure of the AST more approachable for other algorithms
-		// like comparing ranges.
+		// if the version contains wildcards, handle it as range
+		if ((t == token::partial) && p.full_version) {
+			leaf(node::type::op_eq, lower_bound_view(p));
+			return;
+		}
 
-		std::vector<std::unique_ptr<node>> v;
-		collect_leafs_and_andnodes(v, *ast_back());
-		std::sort(begin(v), end(v),
-			[](const auto & a, const auto & b) { return node::less(*a, *b); });
-		ast_ = std::move(v);
+		// caret, tilde or partial: from the lower bound up to the upper bound
+		const auto l = lower_bound_view(p);
+		const auto u = upper_bound_view(p);
+		constexpr auto max = std::numeric_limits<semver::number_type>::max();
+		if (same_precedence(l, u)) {
+			leaf(node::type::op_eq, l);
+		} else if (same_precedence(u, version_tuple(max, max, max))) {
+			leaf(node::type::op_ge, l);
+		} else {
+			leaf(node::type::op_ge, l);
+			leaf(node::type::op_lt, u);
+			sort_leafs(leafs_.size() - 2u);
+		}
 	}
 
-	void start() noexcept
+	// end of an alternative of `n` comparators
+	void clause_end(std::size_t n)
 	{
-		token_ = lex_.scan();
-		token_text_ = lex_.text();
-		next_ = lex_.scan();
-		next_text_ = lex_.text();
+		// multiple comparators are an implicit `and` of all their leafs
+		if (n > 1u)
+			sort_leafs(begin_);
+		alternatives_.push_back({begin_, leafs_.size()});
+		begin_ = leafs_.size();
 	}
 
-	void advance() noexcept
+	// Sorts the alternatives, after the last one was reported.
+	void finish()
 	{
-		token_ = next_;
-		token_text_ = next_text_;
-		next_ = lex_.scan();
-		next_text_ = lex_.text();
+		std::sort(alternatives_.begin(), alternatives_.end(),
+			[this](const alternative & a, const alternative & b) {
+				return less_alternative(leaf_versions {this, a}, leaf_versions {this, b});
+			});
 	}
 
-	void error() noexcept { good_ = false; }
-
-	bool is_eof(token t) const noexcept { return t == token::eof; }
-	bool is_error(token t) const noexcept { return t == token::error; }
-	bool is_caret(token t) const noexcept { return t == token::caret_partial; }
-	bool is_tilde(token t) const noexcept { return t == token::tilde_partial; }
-	bool is_op(token t) const noexcept { return t == token::op_partial; }
-	bool is_logical_or(token t) const noexcept { return t == token::logical_or; }
-	bool is_partial(token t) const noexcept { return t == token::partial; }
-	bool is_dash(token t) const noexcept { return t == token::dash; }
-
-	std::unique_ptr<node> & ast_back() { return ast_.back(); }
-	const std::unique_ptr<node> & ast_back() const { return ast_.back(); }
+	const leaf_list & leafs() const noexcept { return leafs_; }
+	const alternative_list & alternatives() const noexcept { return alternatives_; }
 
-	void ast_push(node && n) { ast_push(std::make_unique<node>(std::move(n))); }
-	void ast_push(std::unique_ptr<node> n) { ast_.push_back(std::move(n)); }
-
-	std::unique_ptr<node> ast_pop()
+	// Returns the AST, after `finish()`.
+	std::vector<std::unique_ptr<node>> ast() const
 	{
-		auto n = std::move(ast_back());
-		ast_.erase(prev(end(ast_)));
-		return n;
+		const auto create = [](const range_leaf & l) {
+			return std::make_unique<node>(node::create_leaf(l.op,
+				semver_parser::create(l.version.major(), l.version.minor(), l.version.patch(),
+					l.version.prerelease())));
+		};
+
+		std::vector<std::unique_ptr<node>> nodes;
+		nodes.reserve(alternatives_.size());
+		for (const auto & a : alternatives_) {
+			if (a.end - a.begin == 1u) {
+				nodes.push_back(create(leafs_[a.begin]));
+				continue;
+			}
+			std::vector<std::unique_ptr<node>> v;
+			v.reserve(a.end - a.begin);
+			for (auto i = a.begin; i < a.end; ++i)
+				v.push_back(create(leafs_[i]));
+			nodes.push_back(
+				std::make_unique<node>(node::create_and_of_sorted_leafs(std::move(v))));
+		}
+		return nodes;
 	}
 
-	void parse_range_set() noexcept
-	{
-		start();
-
-		if (is_eof(token_)) {
-			ast_push(node::create_ge(lower_bound(token_text_)));
-			good_ = true;
-			return;
+private:
+	leaf_list leafs_;
+	alternative_list alternatives_;
+	std::size_t begin_ = 0u; // first leaf of the current alternative
+
+	// versions of the leafs of an alternative, for `less_alternative`
+	struct leaf_versions {
+		const range_builder * b;
+		alternative a;
+
+		std::size_t size() const noexcept { return a.end - a.begin; }
+		const version_tuple & operator[](std::size_t i) const noexcept
+		{
+			return b->leafs_[a.begin + i].version;
 		}
+		node::type op(std::size_t i) const noexcept { return b->leafs_[a.begin + i].op; }
+	};
 
-		parse_range();
-		while (is_logical_or(token_)) {
-			advance(); // logial-or
-			parse_range();
-
-			assert(ast_.size() > 1);
-			auto b = ast_pop();
-			auto a = ast_pop();
-			ast_push(node::create_or(std::move(a), std::move(b)));
-		}
+	void leaf(node::type op, const version_tuple & v) { leafs_.push_back({op, v}); }
 
-		good_ = !is_error(token_);
+	// sorts the leafs from `first` to the end like the children of an `and` node
+	void sort_leafs(std::size_t first)
+	{
+		std::sort(leafs_.begin() + static_cast<std::ptrdiff_t>(first), leafs_.end(),
+			[](const range_leaf & a, const range_leaf & b) {
+				return less_leaf(a.version, a.op, b.version, b.op);
+			});
 	}
+};
 
-	void parse_range() noexcept
+// Parses a range into its AST, a list of `or` connected alternatives, each of them
+// either a leaf or an `and` node of leafs.
+class range_parser final
+{
+public:
+	// The parser does not copy the string, it must outlive the parser.
+	range_parser(std::string_view s, const range_limits & limits = {})
 	{
-		if (is_partial(token_) && is_dash(next_)) {
-			const auto first = token_text_;
-			advance(); // partial
-			advance(); // dash
-			if (is_partial(token_)) {
-				auto l = lower_bound(first);
-
-				// according to the examples provided here: https://github.com/npm/node-semver#versions,
-				// use lower_bound/le if it was a complete partial, upper_bound/lt otherwise
-				auto u = token_text_.full_version ? lower_bound(token_text_)
-												  : upper_bound(token_text_);
-
-				if (l == u) {
-					ast_push(node::create_eq(l));
-				} else {
-					if (l > u)
-						std::swap(l, u);
-					if (token_text_.full_version) {
-						ast_push(node::create_and(node::create_ge(l), node::create_le(u)));
-					} else {
-						ast_push(node::create_and(node::create_ge(l), node::create_lt(u)));
-					}
-				}
-				advance();
-				return;
-			}
-			error();
-			return;
+		// the first pass counts, the second one builds into reserved containers
+		range_size size;
+		const auto syntax = scan_range(s, limits, size);
+		good_ = (syntax == range_syntax::ok);
+		limit_exceeded_ = (syntax == range_syntax::limit_exceeded);
+		if (good_) {
+			range_builder<> b;
+			b.reserve(size.leafs, size.alternatives);
+			scan_range(s, limits, b);
+			b.finish();
+			ast_ = b.ast();
 		}
+	}
 
-		int partial_count = 0; // how may partials are participating in implicit and
-		while (!is_eof(token_) && !is_logical_or(token_)) {
-			++partial_count;
-
-			if (is_caret(token_) || is_tilde(token_)) {
-				auto l = lower_bound(token_text_);
-				auto u = upper_bound(token_text_);
-				if (l == u) {
-					ast_push(node::create_eq(l));
-				} else if (u == semver::max()) {
-					ast_push(node::create_ge(l));
-				} else {
-					ast_push(node::create_and(node::create_ge(l), node::create_lt(u)));
-				}
-				advance();
-				continue;
-			}
-			if (is_op(token_)) {
-				if (token_text_.op == "<")
-					ast_push(node::create_lt(lower_bound(token_text_)));
-				if (token_text_.op == "<=")
-					ast_push(node::create_le(lower_bound(token_text_)));
-				if (token_text_.op == ">")
-					ast_push(node::create_gt(lower_bound(token_text_)));
-				if (token_text_.op == ">=")
-					ast_push(node::create_ge(lower_bound(token_text_)));
-				if (token_text_.op == "=")
-					ast_push(node::create_eq(lower_bound(token_text_)));
-				advance();
-				continue;
-			}
-			if (is_partial(token_)) {
-				// if the version contains wildcards, handle it as range
-				if (token_text_.full_version) {
-					ast_push(node::create_eq(lower_bound(token_text_)));
-				} else {
-					auto l = lower_bound(token_text_);
-					auto u = upper_bound(token_text_);
-					if (l == u) {
-						ast_push(node::create_eq(l));
-					} else if (u == semver::max()) {
-						ast_push(node::create_ge(l));
-					} else {
-						ast_push(node::create_and(node::create_ge(l), node::create_lt(u)));
-					}
-				}
-				advance();
-				continue;
-			}
+	bool ok() const noexcept { return good_; }
 
-			error();
-			return;
-		}
+	// Returns true if parsing stopped because of the limits.
+	bool limit_exceeded() const noexcept { return limit_exceeded_; }
 
-		// are there multiple leafs and therefore an implicit 'and'?
-		if (partial_count > 1) {
-			std::vector<std::unique_ptr<node>> v;
-			for (; partial_count > 0 && ast_back()->is_leaf(); --partial_count)
-				v.push_back(ast_pop());
-			ast_push(node::create_and(std::move(v)));
-		}
+	std::vector<std::unique_ptr<node>> && ast()
+	{
+		good_ = false;
+		return std::move(ast_);
 	}
+
+private:
+	bool good_ = false;
+	bool limit_exceeded_ = false;
+	std::vector<std::unique_ptr<node>> ast_;
 };
 }
 }
@@ -3,7 +3,11 @@
 
 #include <algorithm>
 #include <charconv>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <semver/semver.hpp>
+#include <semver/statistics.hpp>
 
 #include <semver/glibc-bugfix.hpp> // must be included last
 
@@ -12,37 +16,65 @@ namespace semver
 {
 inline namespace v1
 {
-class semver; // forward
-
 namespace detail
 {
 class semver_parser final
 {
 	friend class ::semver::v1::semver;
 public:
-	using number_type = unsigned long;
+	using number_type = semver::number_type;
+
+	// Creates a version from parts which were already validated by a parser,
+	// e.g. the range lexer, without validating them again.
+	static semver create(number_type major, number_type minor, number_type patch,
+		std::string_view prerelease = {}, std::string_view build = {})
+	{
+		semver v(major, minor, patch);
+		v.prerelease_ = prerelease;
+		v.build_ = build;
+		return v;
+	}
+
+	// Sets the numerical core of a version decoded from trusted data, prerelease and
+	// build are written directly, reusing the strings of `v`.
+	static void assign_core(semver & v, number_type major, number_type minor,
+		number_type patch) noexcept
+	{
+		v.major_ = major;
+		v.minor_ = minor;
+		v.patch_ = patch;
+		v.good_ = true;
+	}
 
-	static number_type ston(const std::string & s) { return std::stoul(s); }
+	static std::string & prerelease(semver & v) noexcept { return v.prerelease_; }
+	static std::string & build(semver & v) noexcept { return v.build_; }
 
-	semver_parser(const std::string & s, bool loose = false)
-		: data_(s)
+	// Parses the string in place, only loose parsing needs a copy, which is
+	// allocated from `mr`. Prerelease and build refer to the parsed string
+	// or the copy, the parser can therefore neither be copied nor moved.
+	semver_parser(std::string_view s, bool loose = false,
+		std::pmr::memory_resource * mr = std::pmr::get_default_resource())
+		: data_(mr)
 	{
 		if (loose) {
+			data_.assign(s.data(), s.size());
 			data_.erase(std::remove_if(begin(data_), end(data_), ::isspace), end(data_));
 			data_.erase(begin(data_), std::find_if(begin(data_), end(data_), ::isdigit));
+			s = data_;
 		}
 
-		last_ = data_.data() + data_.size();
-		cursor_ = data_.data();
+		first_ = s.data();
+		last_ = s.data() + s.size();
+		cursor_ = s.data();
 
-		if (!data_.empty()) {
+		if (!s.empty()) {
 			parse_valid_semver();
 			good_ = (cursor_ == last_) && !error_;
 		}
 	}
 
 	semver_parser(
-		number_type major, number_type minor, number_type patch, const std::string & prerelease)
+		number_type major, number_type minor, number_type patch, std::string_view prerelease)
 		: major_(major)
 		, minor_(minor)
 		, patch_(patch)
@@ -54,7 +86,7 @@ public:
 	}
 
 	semver_parser(number_type major, number_type minor, number_type patch,
-		const std::string & prerelease, const std::string & build)
+		std::string_view prerelease, std::string_view build)
 		: major_(major)
 		, minor_(minor)
 		, patch_(patch)
@@ -71,16 +103,41 @@ public:
 		}
 	}
 
+	semver_parser(const semver_parser &) = delete;
+	semver_parser & operator=(const semver_parser &) = delete;
+
 	bool ok() const noexcept { return good_; }
 	number_type major() const noexcept { return major_; }
 	number_type minor() const noexcept { return minor_; }
 	number_type patch() const noexcept { return patch_; }
-	const std::string & build() const noexcept { return build_; }
-	const std::string & prerelease() const noexcept { return prerelease_; }
+	std::string_view build() const noexcept { return build_; }
+	std::string_view prerelease() const noexcept { return prerelease_; }
+
+	// Returns why parsing a string failed, only meaningful if it did.
+	parse_failure failure() const noexcept
+	{
+		if (first_ == last_)
+			return parse_failure::empty;
+		if (!error_)
+			return parse_failure::trailing;
+
+		const auto s = std::string_view(first_, static_cast<std::size_t>(last_ - first_));
+		const auto at = static_cast<std::size_t>(error_ - first_);
+		const auto sep = s.find_first_of("-+");
+		if ((sep == std::string_view::npos) || (at <= sep))
+			return parse_failure::version_core;
+		if (s[sep] == '-') {
+			const auto plus = s.find('+', sep);
+			if ((plus == std::string_view::npos) || (at <= plus))
+				return parse_failure::prerelease;
+		}
+		return parse_failure::build;
+	}
 
 private:
-	using char_type = std::string::value_type;
+	using char_type = std::string_view::value_type;
 
+	const char_type * first_ = {};
 	const char_type * last_ = {};
 	const char_type * start_ = {};
 	const char_type * cursor_ = {};
@@ -89,10 +146,10 @@ private:
 	number_type major_ = {};
 	number_type minor_ = {};
 	number_type patch_ = {};
-	std::string prerelease_ = {};
-	std::string build_ = {};
+	std::string_view prerelease_ = {};
+	std::string_view build_ = {};
 
-	std::string data_;
+	std::pmr::string data_;
 	bool good_ = false;
 
 	bool only_parse_prerelease()
@@ -111,9 +168,9 @@ private:
 		return (cursor_ == last_) && !error_;
 	}
 
-	static std::string token(const char_type * start, const char_type * end) noexcept
+	static std::string_view token(const char_type * start, const char_type * end) noexcept
 	{
-		return std::string(start, end);
+		return std::string_view(start, static_cast<std::size_t>(end - start));
 	}
 
 	void parse_valid_semver() noexcept
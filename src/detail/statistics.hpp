@@ -0,0 +1,167 @@
+#ifndef SEMVER_DETAIL_STATISTICS_HPP
+#define SEMVER_DETAIL_STATISTICS_HPP
+
+#include <semver/statistics.hpp>
+#include <cstdint>
+
+#if defined(SEMVER_STATISTICS)
+	#include <atomic>
+	#include <chrono>
+#endif
+
+// Instrumentation of the library, see `semver/statistics.hpp`. Without
+// `SEMVER_STATISTICS` all functions and types are empty and compiled away.
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+#if defined(SEMVER_STATISTICS)
+// index of the counters within the counters of a thread
+namespace counter
+{
+constexpr std::size_t versions_parsed = 0u;
+constexpr std::size_t ranges_parsed = 1u;
+constexpr std::size_t parse_failures = 2u;
+constexpr std::size_t satisfies_calls = parse_failures + parse_failure_count;
+constexpr std::size_t nodes_visited = satisfies_calls + 1u;
+constexpr std::size_t comparisons = nodes_visited + 1u;
+constexpr std::size_t prerelease_comparisons = comparisons + 1u;
+constexpr std::size_t latencies = prerelease_comparisons + 1u;
+
+// per histogram: buckets, samples, total duration
+constexpr std::size_t latency_size = latency_histogram::bucket_count + 2u;
+constexpr std::size_t count = latencies + latency_count * latency_size;
+}
+
+// Counters of one thread. They are written only by the thread, without
+// atomic read-modify-write operations, and read by snapshots of other threads.
+struct thread_counters {
+	std::atomic<std::uint64_t> values[counter::count] = {};
+	unsigned int sample_tick = 0u;
+
+	// list of the counters of living threads, protected by the lock of the registry
+	thread_counters * prev = nullptr;
+	thread_counters * next = nullptr;
+
+	void add(std::size_t i, std::uint64_t n = 1u) noexcept
+	{
+		values[i].store(values[i].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+};
+
+// Returns the counters of the calling thread, registered for snapshots.
+thread_counters & local_counters() noexcept;
+
+// Returns true if the current operation is to be measured.
+bool sample_latency() noexcept;
+
+void record_latency(latency l, std::chrono::steady_clock::duration d) noexcept;
+
+inline void stats_version_parsed() noexcept
+{
+	local_counters().add(counter::versions_parsed);
+}
+
+inline void stats_range_parsed() noexcept
+{
+	local_counters().add(counter::ranges_parsed);
+}
+
+inline void stats_parse_failed(parse_failure reason) noexcept
+{
+	local_counters().add(counter::parse_failures + static_cast<std::size_t>(reason));
+}
+
+// `Parser` provides the reason, it is determined only if counted.
+template <typename Parser> void stats_version_failed(const Parser & p) noexcept
+{
+	stats_parse_failed(p.failure());
+}
+
+inline void stats_satisfies(std::uint64_t nodes_visited) noexcept
+{
+	auto & c = local_counters();
+	c.add(counter::satisfies_calls);
+	c.add(counter::nodes_visited, nodes_visited);
+}
+
+template <typename V> void stats_comparison(const V & v1, const V & v2) noexcept
+{
+	auto & c = local_counters();
+	c.add(counter::comparisons);
+	if ((v1.major() == v2.major()) && (v1.minor() == v2.minor()) && (v1.patch() == v2.patch()))
+		c.add(counter::prerelease_comparisons);
+}
+
+// Counts evaluated nodes, to be passed by value into the evaluation.
+class node_visit final
+{
+public:
+	explicit node_visit(std::uint64_t * count) noexcept
+		: count_(count)
+	{
+	}
+
+	void operator()() const noexcept { ++*count_; }
+
+private:
+	std::uint64_t * count_;
+};
+
+// Measures the duration of its lifetime, if sampled.
+class latency_timer final
+{
+public:
+	explicit latency_timer(latency l) noexcept
+		: latency_(l)
+		, sampled_(sample_latency())
+	{
+		if (sampled_)
+			start_ = std::chrono::steady_clock::now();
+	}
+
+	~latency_timer()
+	{
+		if (sampled_)
+			record_latency(latency_, std::chrono::steady_clock::now() - start_);
+	}
+
+	latency_timer(const latency_timer &) = delete;
+	latency_timer & operator=(const latency_timer &) = delete;
+
+private:
+	latency latency_;
+	bool sampled_;
+	std::chrono::steady_clock::time_point start_ = {};
+};
+#else
+inline void stats_version_parsed() noexcept {}
+inline void stats_range_parsed() noexcept {}
+inline void stats_parse_failed(parse_failure) noexcept {}
+template <typename Parser> void stats_version_failed(const Parser &) noexcept {}
+inline void stats_satisfies(std::uint64_t) noexcept {}
+template <typename V> void stats_comparison(const V &, const V &) noexcept {}
+
+class node_visit final
+{
+public:
+	explicit node_visit(std::uint64_t *) noexcept {}
+	void operator()() const noexcept {}
+};
+
+class latency_timer final
+{
+public:
+	explicit latency_timer(latency) noexcept {}
+
+	latency_timer(const latency_timer &) = delete;
+	latency_timer & operator=(const latency_timer &) = delete;
+};
+#endif
+}
+}
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef SEMVER_DETAIL_THREAD_LIST_HPP
+#define SEMVER_DETAIL_THREAD_LIST_HPP
+
+#include <mutex>
+#include <new>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+// Returns the instance of `T`. It is never destroyed, threads may finish after static
+// destruction. It is constructed in static storage, the first use does not allocate.
+template <typename T> T & static_instance()
+{
+	alignas(T) static unsigned char storage[sizeof(T)];
+	static auto * p = new (storage) T;
+	return *p;
+}
+
+// Intrusive list of nodes of living threads, registering a thread does not allocate.
+// `Node` provides the members `prev` and `next`, initialized to `nullptr`.
+template <typename Node> class thread_list final
+{
+public:
+	using node_type = Node;
+
+	std::mutex mutex;
+
+	// Calls `f` for all nodes, the list must be locked.
+	template <typename F> void for_each(F f) const
+	{
+		for (const auto * n = head_; n; n = n->next)
+			f(*n);
+	}
+
+	// The list must be locked.
+	void insert(Node & n) noexcept
+	{
+		n.next = head_;
+		if (head_)
+			head_->prev = &n;
+		head_ = &n;
+	}
+
+	// The list must be locked.
+	void erase(Node & n) noexcept
+	{
+		if (n.prev)
+			n.prev->next = n.next;
+		else
+			head_ = n.next;
+		if (n.next)
+			n.next->prev = n.prev;
+	}
+
+private:
+	Node * head_ = nullptr;
+};
+
+// Registers a node of the calling thread in `Owner::threads` of the instance of
+// `Owner` for the lifetime of the thread. `Owner::leave` is called with the node
+// while the list is locked, before the node is removed.
+template <typename Owner> class thread_registration final
+{
+public:
+	using node_type = typename decltype(Owner::threads)::node_type;
+
+	thread_registration()
+	{
+		auto & owner = static_instance<Owner>();
+		const std::lock_guard lock(owner.threads.mutex);
+		owner.threads.insert(node);
+	}
+
+	~thread_registration()
+	{
+		auto & owner = static_instance<Owner>();
+		const std::lock_guard lock(owner.threads.mutex);
+		owner.leave(node);
+		owner.threads.erase(node);
+	}
+
+	thread_registration(const thread_registration &) = delete;
+	thread_registration & operator=(const thread_registration &) = delete;
+
+	node_type node;
+};
+}
+}
+}
+
+#endif
@@ -0,0 +1,225 @@
+#include <semver/key.hpp>
+#include "detail/semver_parser.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+namespace
+{
+// tags of the key format, do not change
+constexpr char key_prerelease_end = '\x00';
+constexpr char key_numeric = '\x01';
+constexpr char key_alphanumeric = '\x02';
+constexpr char key_release = '\x03';
+
+// leading zeros of numeric identifiers are counted, more are not encodable
+constexpr std::size_t key_max_leading_zeros = 0xffffu;
+
+void write_key_number(std::string & out, semver::number_type n)
+{
+	char buf[sizeof(n)];
+	std::size_t size = 0u;
+	for (; n != 0u; n >>= 8)
+		buf[size++] = static_cast<char>(n & 0xffu);
+	out += static_cast<char>(size);
+	for (std::size_t i = size; i > 0u; --i)
+		out += buf[i - 1u];
+}
+
+// Reads a number, advances `data` past it. Non minimal encodings are not valid.
+bool read_key_number(std::string_view & data, semver::number_type & n) noexcept
+{
+	if (data.empty())
+		return false;
+	const auto size = static_cast<unsigned char>(data.front());
+	if ((size > sizeof(n)) || (data.size() <= size))
+		return false;
+	if ((size > 0u) && (data[1] == '\0'))
+		return false;
+	n = 0u;
+	for (std::size_t i = 1u; i <= size; ++i)
+		n = (n << 8) | static_cast<unsigned char>(data[i]);
+	data.remove_prefix(size + 1u);
+	return true;
+}
+
+bool is_digit(char c) noexcept
+{
+	return (c >= '0') && (c <= '9');
+}
+
+bool is_identifier_char(char c) noexcept
+{
+	return is_digit(c) || ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '-');
+}
+
+bool is_numeric(std::string_view s) noexcept
+{
+	return std::all_of(begin(s), end(s), is_digit);
+}
+
+bool write_key_identifier(std::string & out, std::string_view id)
+{
+	if (is_numeric(id)) {
+		// the significant digits determine the order, the leading zeros are kept
+		// to restore the identifier and to order identifiers of the same number
+		const auto zeros = std::min(id.find_first_not_of('0'), id.size() - 1u);
+		if (zeros > key_max_leading_zeros)
+			return false;
+		const auto digits = id.substr(zeros);
+		out += key_numeric;
+		write_key_number(out, digits.size());
+		out.append(digits.data(), digits.size());
+		write_key_number(out, zeros);
+	} else {
+		out += key_alphanumeric;
+		out.append(id.data(), id.size());
+		out += '\0';
+	}
+	return true;
+}
+
+// Reads an identifier and appends it to `prerelease`. Only canonical identifiers
+// are valid: numeric ones with their significant digits not starting with a zero,
+// alphanumeric ones not being numeric.
+bool read_key_identifier(std::string_view & data, std::string & prerelease)
+{
+	const auto tag = data.front();
+	data.remove_prefix(1u);
+	if (tag == key_numeric) {
+		semver::number_type size = 0u;
+		if (!read_key_number(data, size) || (size == 0u) || (size > data.size()))
+			return false;
+		const auto digits = data.substr(0u, size);
+		if (!is_numeric(digits) || ((digits.size() > 1u) && (digits.front() == '0')))
+			return false;
+		data.remove_prefix(size);
+		semver::number_type zeros = 0u;
+		if (!read_key_number(data, zeros) || (zeros > key_max_leading_zeros))
+			return false;
+		prerelease.append(zeros, '0');
+		prerelease.append(digits.data(), digits.size());
+		return true;
+	}
+	if (tag == key_alphanumeric) {
+		const auto end = data.find('\0');
+		if ((end == 0u) || (end == std::string_view::npos))
+			return false;
+		const auto id = data.substr(0u, end);
+		if (!std::all_of(begin(id), std::end(id), is_identifier_char) || is_numeric(id))
+			return false;
+		prerelease.append(id.data(), id.size());
+		data.remove_prefix(end + 1u);
+		return true;
+	}
+	return false;
+}
+}
+}
+
+bool encode_key(const semver & v, std::string & out)
+{
+	if (!v.ok())
+		return false;
+
+	const auto size = out.size();
+	detail::write_key_number(out, v.major());
+	detail::write_key_number(out, v.minor());
+	detail::write_key_number(out, v.patch());
+
+	std::string_view pr = v.prerelease();
+	if (pr.empty()) {
+		out += detail::key_release;
+		return true;
+	}
+	for (;;) {
+		const auto dot = pr.find('.');
+		if (!detail::write_key_identifier(out, pr.substr(0u, dot))) {
+			out.resize(size);
+			return false;
+		}
+		if (dot == std::string_view::npos)
+			break;
+		pr.remove_prefix(dot + 1u);
+	}
+	out += detail::key_prerelease_end;
+	return true;
+}
+
+std::string to_key(const semver & v)
+{
+	std::string key;
+	encode_key(v, key);
+	return key;
+}
+
+std::size_t decode_key(std::string_view data, semver & v)
+{
+	const auto size = data.size();
+
+	semver::number_type major = 0u;
+	semver::number_type minor = 0u;
+	semver::number_type patch = 0u;
+	if (!detail::read_key_number(data, major) || !detail::read_key_number(data, minor)
+		|| !detail::read_key_number(data, patch) || data.empty())
+		return 0u;
+
+	if (data.front() == detail::key_release) {
+		v = semver(major, minor, patch);
+		return size - data.size() + 1u;
+	}
+
+	std::string prerelease;
+	while (data.front() != detail::key_prerelease_end) {
+		if (!prerelease.empty())
+			prerelease += '.';
+		if (!detail::read_key_identifier(data, prerelease) || data.empty())
+			return 0u;
+	}
+	if (prerelease.empty())
+		return 0u;
+
+	v = detail::semver_parser::create(major, minor, patch, prerelease);
+	return size - data.size() + 1u;
+}
+
+semver from_key(std::string_view key)
+{
+	semver v;
+	if (decode_key(key, v) != key.size())
+		return semver::invalid();
+	return v;
+}
+
+std::vector<key_interval> key_intervals(const range & r)
+{
+	std::vector<key_interval> result;
+	if (!r.ok())
+		return result;
+
+	// Keys are prefix free, there is no key between the key `k` and `k + '\0'`,
+	// the latter is therefore the start after an exclusive lower bound, and the end
+	// after an inclusive upper bound.
+	for (const auto & [lower, upper] : r.intervals()) {
+		key_interval i;
+		if (!lower.unbounded) {
+			encode_key(lower.version, i.start);
+			if (!lower.inclusive)
+				i.start += '\0';
+		}
+		if (!upper.unbounded) {
+			encode_key(upper.version, i.end);
+			if (upper.inclusive)
+				i.end += '\0';
+		}
+		result.push_back(std::move(i));
+	}
+	return result;
+}
+}
+}
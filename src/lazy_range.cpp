@@ -0,0 +1,58 @@
+#include <semver/lazy_range.hpp>
+#include "detail/range_parser.hpp"
+#include <ostream>
+
+namespace semver
+{
+inline namespace v1
+{
+lazy_range::lazy_range(std::string s, range_check check, const range_limits & limits)
+	: text_(std::move(s))
+	, limits_(limits)
+	, syntax_ok_((check == range_check::none) || detail::check_range_syntax(text_, limits_))
+{
+}
+
+lazy_range::lazy_range(const lazy_range & other)
+	: text_(other.text_)
+	, limits_(other.limits_)
+	, syntax_ok_(other.syntax_ok_)
+{
+}
+
+lazy_range::lazy_range(lazy_range && other) noexcept
+	: text_(std::move(other.text_))
+	, limits_(other.limits_)
+	, syntax_ok_(other.syntax_ok_)
+{
+	if (other.compiled()) {
+		range_ = std::move(other.range_);
+		std::call_once(once_, [this] { compiled_.store(true, std::memory_order_release); });
+	}
+}
+
+const range & lazy_range::get() const
+{
+	std::call_once(once_, [this] {
+		range_.emplace(text_, limits_);
+		compiled_.store(true, std::memory_order_release);
+	});
+	return *range_;
+}
+
+bool lazy_range::ok() const
+{
+	return syntax_ok_ && get().ok();
+}
+
+std::string to_string(const lazy_range & r)
+{
+	return to_string(r.get());
+}
+
+std::ostream & operator<<(std::ostream & os, const lazy_range & r)
+{
+	return os << r.get();
+}
+}
+}
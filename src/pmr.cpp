@@ -0,0 +1,479 @@
+#include <semver/pmr.hpp>
+#include "detail/precedence.hpp"
+#include "detail/range_node.hpp"
+#include "detail/range_parser.hpp"
+#include "detail/semver_parser.hpp"
+#include "detail/statistics.hpp"
+#include <algorithm>
+#include <limits>
+#include <ostream>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace pmr
+{
+semver::semver(const allocator_type & alloc) noexcept
+	: prerelease_(alloc)
+	, build_(alloc)
+{
+}
+
+semver::semver(std::string_view s, const allocator_type & alloc)
+	: semver(s, false, alloc)
+{
+}
+
+semver::semver(std::string_view s, bool loose, const allocator_type & alloc)
+	: prerelease_(alloc)
+	, build_(alloc)
+{
+	[[maybe_unused]] const detail::latency_timer timer(latency::version_parse);
+
+	const auto p = detail::semver_parser(s, loose, alloc.resource());
+	good_ = p.ok();
+	if (good_) {
+		major_ = p.major();
+		minor_ = p.minor();
+		patch_ = p.patch();
+		prerelease_ = p.prerelease();
+		build_ = p.build();
+		detail::stats_version_parsed();
+	} else {
+		detail::stats_version_failed(p);
+	}
+}
+
+semver::semver(
+	number_type major, number_type minor, number_type patch, const allocator_type & alloc)
+	: major_(major)
+	, minor_(minor)
+	, patch_(patch)
+	, prerelease_(alloc)
+	, build_(alloc)
+	, good_(true)
+{
+}
+
+semver::semver(number_type major, number_type minor, number_type patch,
+	std::string_view prerelease, std::string_view build, const allocator_type & alloc)
+	: major_(major)
+	, minor_(minor)
+	, patch_(patch)
+	, prerelease_(alloc)
+	, build_(alloc)
+	, good_(detail::semver_parser(major, minor, patch, prerelease, build).ok())
+{
+	if (good_) {
+		prerelease_ = prerelease;
+		build_ = build;
+	}
+}
+
+semver::semver(const ::semver::semver & v, const allocator_type & alloc)
+	: major_(v.major())
+	, minor_(v.minor())
+	, patch_(v.patch())
+	, prerelease_(v.prerelease(), alloc)
+	, build_(v.build(), alloc)
+	, good_(v.ok())
+{
+}
+
+semver::semver(const semver & other, const allocator_type & alloc)
+	: major_(other.major_)
+	, minor_(other.minor_)
+	, patch_(other.patch_)
+	, prerelease_(other.prerelease_, alloc)
+	, build_(other.build_, alloc)
+	, good_(other.good_)
+{
+}
+
+semver::semver(semver && other, const allocator_type & alloc)
+	: major_(other.major_)
+	, minor_(other.minor_)
+	, patch_(other.patch_)
+	, prerelease_(std::move(other.prerelease_), alloc)
+	, build_(std::move(other.build_), alloc)
+	, good_(other.good_)
+{
+}
+
+std::pmr::string semver::str() const
+{
+	std::pmr::string s(get_allocator());
+	s.reserve(formatted_size(*this));
+	detail::format_semver(*this, [&s](const char * p, std::size_t n) { s.append(p, n); });
+	return s;
+}
+
+::semver::semver semver::to_semver() const
+{
+	if (!good_)
+		return ::semver::semver::invalid();
+	return detail::semver_parser::create(major_, minor_, patch_, prerelease_, build_);
+}
+
+std::ostream & operator<<(std::ostream & os, const semver & v)
+{
+	detail::format_semver(v, [&os](const char * s, std::size_t n) {
+		os.write(s, static_cast<std::streamsize>(n));
+	});
+	return os;
+}
+
+std::size_t formatted_size(const semver & v) noexcept
+{
+	std::size_t size = 0u;
+	detail::format_semver(v, [&size](const char *, std::size_t n) { size += n; });
+	return size;
+}
+
+bool operator==(const semver & v1, const semver & v2) noexcept
+{
+	return detail::same_precedence(v1, v2);
+}
+
+bool operator!=(const semver & v1, const semver & v2) noexcept
+{
+	return !(v1 == v2);
+}
+
+bool operator<(const semver & v1, const semver & v2) noexcept
+{
+	detail::stats_comparison(v1, v2);
+	return detail::precedes(v1, v2);
+}
+
+bool operator<=(const semver & v1, const semver & v2) noexcept
+{
+	return (v1 == v2) || (v1 < v2);
+}
+
+bool operator>(const semver & v1, const semver & v2) noexcept
+{
+	return !(v1 <= v2);
+}
+
+bool operator>=(const semver & v1, const semver & v2) noexcept
+{
+	return !(v1 < v2);
+}
+
+int compare(const semver & v1, const semver & v2) noexcept
+{
+	return (v1 == v2) ? 0 : (v1 < v2) ? -1 : +1;
+}
+
+namespace
+{
+// version of a comparator, its prerelease refers to the strings of the range
+struct comparator_version {
+	semver::number_type major_ = {};
+	semver::number_type minor_ = {};
+	semver::number_type patch_ = {};
+	std::string_view prerelease_ = {};
+
+	semver::number_type major() const noexcept { return major_; }
+	semver::number_type minor() const noexcept { return minor_; }
+	semver::number_type patch() const noexcept { return patch_; }
+	std::string_view prerelease() const noexcept { return prerelease_; }
+	std::string_view build() const noexcept { return {}; }
+	bool ok() const noexcept { return true; }
+};
+
+// operator of a comparator of a leaf
+template <typename Op> Op op_of(detail::node::type t) noexcept
+{
+	using type = detail::node::type;
+	switch (t) {
+		case type::op_lt:
+			return Op::lt;
+		case type::op_le:
+			return Op::le;
+		case type::op_gt:
+			return Op::gt;
+		case type::op_ge:
+			return Op::ge;
+		case type::op_eq:
+		case type::op_and:
+		case type::op_or:
+			break;
+	}
+	return Op::eq;
+}
+}
+
+range::range(const allocator_type & alloc) noexcept
+	: comparators_(alloc)
+	, clause_ends_(alloc)
+	, prereleases_(alloc)
+{
+}
+
+range::range(std::string_view s, const allocator_type & alloc)
+	: range(s, range_limits {}, alloc)
+{
+}
+
+range::range(std::string_view s, const range_limits & limits, const allocator_type & alloc)
+	: range(alloc)
+{
+	[[maybe_unused]] const detail::latency_timer timer(latency::range_parse);
+
+	// the first pass counts, the second one builds into reserved containers
+	detail::range_size size;
+	const auto syntax = detail::scan_range(s, limits, size);
+	if (syntax != detail::range_syntax::ok) {
+		detail::stats_parse_failed((syntax == detail::range_syntax::limit_exceeded)
+				? parse_failure::range_limit
+				: parse_failure::range_syntax);
+		return;
+	}
+
+	detail::range_builder<std::pmr::polymorphic_allocator<detail::range_leaf>> b(alloc);
+	b.reserve(size.leafs, size.alternatives);
+	detail::scan_range(s, limits, b);
+	b.finish();
+
+	std::size_t prereleases = 0u;
+	for (const auto & l : b.leafs())
+		prereleases += l.version.prerelease().size();
+	if ((b.leafs().size() > std::numeric_limits<std::uint32_t>::max())
+		|| (prereleases > std::numeric_limits<std::uint32_t>::max()))
+		return;
+
+	comparators_.reserve(b.leafs().size());
+	clause_ends_.reserve(b.alternatives().size());
+	prereleases_.reserve(prereleases);
+	for (const auto & a : b.alternatives()) {
+		for (auto i = a.begin; i < a.end; ++i) {
+			const auto & l = b.leafs()[i];
+			comparators_.push_back({op_of<op>(l.op), l.version.major(), l.version.minor(),
+				l.version.patch(), static_cast<std::uint32_t>(prereleases_.size()),
+				static_cast<std::uint32_t>(l.version.prerelease().size())});
+			prereleases_ += l.version.prerelease();
+		}
+		clause_ends_.push_back(static_cast<std::uint32_t>(comparators_.size()));
+	}
+	good_ = true;
+	detail::stats_range_parsed();
+}
+
+range::range(const ::semver::range & r, const allocator_type & alloc)
+	: range(alloc)
+{
+	if (r.ok())
+		assign(r.nodes_);
+}
+
+void range::assign(const std::vector<std::unique_ptr<detail::node>> & nodes)
+{
+	// sizes are known up front, the memory resource is asked once per container
+	std::size_t comparators = 0u;
+	std::size_t prereleases = 0u;
+	for (const auto & n : nodes) {
+		n->visit_prefix([&comparators, &prereleases](const detail::node & c) {
+			if (c.is_leaf()) {
+				++comparators;
+				prereleases += c.get_version().prerelease().size();
+			}
+		});
+	}
+	if ((comparators > std::numeric_limits<std::uint32_t>::max())
+		|| (prereleases > std::numeric_limits<std::uint32_t>::max()))
+		return;
+
+	comparators_.reserve(comparators);
+	clause_ends_.reserve(nodes.size());
+	prereleases_.reserve(prereleases);
+
+	for (const auto & n : nodes) {
+		n->visit_prefix([this](const detail::node & c) {
+			if (!c.is_leaf())
+				return;
+
+			const auto & v = c.get_version();
+			comparator x;
+			x.type = op_of<op>(c.get_type());
+			x.major = v.major();
+			x.minor = v.minor();
+			x.patch = v.patch();
+			x.prerelease_offset = static_cast<std::uint32_t>(prereleases_.size());
+			x.prerelease_size = static_cast<std::uint32_t>(v.prerelease().size());
+			prereleases_ += v.prerelease();
+			comparators_.push_back(x);
+		});
+		clause_ends_.push_back(static_cast<std::uint32_t>(comparators_.size()));
+	}
+	good_ = true;
+}
+
+range::range(const range & other, const allocator_type & alloc)
+	: good_(other.good_)
+	, comparators_(other.comparators_, alloc)
+	, clause_ends_(other.clause_ends_, alloc)
+	, prereleases_(other.prereleases_, alloc)
+{
+}
+
+range::range(range && other, const allocator_type & alloc)
+	: good_(other.good_)
+	, comparators_(std::move(other.comparators_), alloc)
+	, clause_ends_(std::move(other.clause_ends_), alloc)
+	, prereleases_(std::move(other.prereleases_), alloc)
+{
+}
+
+template <typename V> bool range::eval(const V & v) const noexcept
+{
+	if (!good_ || !v.ok())
+		return false;
+
+	// alternatives are `or` connected, their comparators `and` connected
+	const std::string_view prereleases = prereleases_;
+	std::size_t i = 0u;
+	for (const auto end : clause_ends_) {
+		bool all = true;
+		for (; all && (i < end); ++i) {
+			const auto & c = comparators_[i];
+			const auto x = comparator_version {c.major, c.minor, c.patch,
+				prereleases.substr(c.prerelease_offset, c.prerelease_size)};
+			switch (c.type) {
+				case op::eq:
+					all = detail::same_precedence(v, x);
+					break;
+				case op::lt:
+					all = detail::precedes(v, x);
+					break;
+				case op::le:
+					all = !detail::precedes(x, v);
+					break;
+				case op::gt:
+					all = detail::precedes(x, v);
+					break;
+				case op::ge:
+					all = !detail::precedes(v, x);
+					break;
+			}
+		}
+		if (all)
+			return true;
+		i = end;
+	}
+	return false;
+}
+
+bool range::satisfies(const semver & v) const noexcept
+{
+	return eval(v);
+}
+
+bool range::satisfies(const ::semver::semver & v) const noexcept
+{
+	return eval(v);
+}
+
+::semver::range range::to_range() const
+{
+	if (!good_)
+		return ::semver::range();
+
+	const auto create = [this](const comparator & c) {
+		const auto v = detail::semver_parser::create(c.major, c.minor, c.patch,
+			std::string_view(prereleases_).substr(c.prerelease_offset, c.prerelease_size));
+		switch (c.type) {
+			case op::lt:
+				return detail::node::create_lt(v);
+			case op::le:
+				return detail::node::create_le(v);
+			case op::gt:
+				return detail::node::create_gt(v);
+			case op::ge:
+				return detail::node::create_ge(v);
+			case op::eq:
+				break;
+		}
+		return detail::node::create_eq(v);
+	};
+
+	std::vector<std::unique_ptr<detail::node>> nodes;
+	nodes.reserve(clause_ends_.size());
+	std::size_t i = 0u;
+	for (const auto end : clause_ends_) {
+		if (end - i == 1u) {
+			nodes.push_back(std::make_unique<detail::node>(create(comparators_[i++])));
+			continue;
+		}
+		std::vector<std::unique_ptr<detail::node>> leafs;
+		leafs.reserve(end - i);
+		for (; i < end; ++i)
+			leafs.push_back(std::make_unique<detail::node>(create(comparators_[i])));
+		nodes.push_back(std::make_unique<detail::node>(detail::node::create_and(std::move(leafs))));
+	}
+	return ::semver::range(std::move(nodes));
+}
+
+template <typename Write> void range::format(Write && write) const
+{
+	static constexpr std::string_view ops[] = {"=", "<", "<=", ">", ">="};
+
+	const std::string_view prereleases = prereleases_;
+	std::size_t i = 0u;
+	for (const auto end : clause_ends_) {
+		if (i > 0u)
+			write(" || ", 4u);
+		for (const auto first = i; i < end; ++i) {
+			const auto & c = comparators_[i];
+			if (i > first)
+				write(" ", 1u);
+			const auto o = ops[static_cast<std::size_t>(c.type)];
+			write(o.data(), o.size());
+			detail::format_semver(comparator_version {c.major, c.minor, c.patch,
+									  prereleases.substr(c.prerelease_offset, c.prerelease_size)},
+				write);
+		}
+	}
+}
+
+std::ostream & operator<<(std::ostream & os, const range & r)
+{
+	r.format([&os](const char * s, std::size_t n) {
+		os.write(s, static_cast<std::streamsize>(n));
+	});
+	return os;
+}
+
+std::string to_string(const range & r)
+{
+	std::string s;
+	r.format([&s](const char * p, std::size_t n) { s.append(p, n); });
+	return s;
+}
+
+bool operator==(const range & r1, const range & r2) noexcept
+{
+	if ((r1.good_ != r2.good_) || (r1.clause_ends_ != r2.clause_ends_)
+		|| (r1.comparators_.size() != r2.comparators_.size()))
+		return false;
+
+	const std::string_view p1 = r1.prereleases_;
+	const std::string_view p2 = r2.prereleases_;
+	return std::equal(begin(r1.comparators_), end(r1.comparators_), begin(r2.comparators_),
+		[p1, p2](const auto & a, const auto & b) {
+			return (a.type == b.type) && (a.major == b.major) && (a.minor == b.minor)
+				&& (a.patch == b.patch)
+				&& (p1.substr(a.prerelease_offset, a.prerelease_size)
+					== p2.substr(b.prerelease_offset, b.prerelease_size));
+		});
+}
+
+bool operator!=(const range & r1, const range & r2) noexcept
+{
+	return !(r1 == r2);
+}
+}
+}
+}
@@ -1,6 +1,12 @@
 #include <semver/range.hpp>
+#include <semver/binary.hpp>
 #include "detail/range_node.hpp"
 #include "detail/range_parser.hpp"
+#include "detail/semver_parser.hpp"
+#include "detail/statistics.hpp"
+#include <algorithm>
+#include <iterator>
+#include <utility>
 #include <cassert>
 
 namespace semver
@@ -9,128 +15,533 @@ inline namespace v1
 {
 namespace detail
 {
-template <typename Iterator, typename Predicate>
-typename Iterator::value_type satisfies_if(
-	const range & r,
-	Iterator first, Iterator last, Predicate pred) noexcept
+namespace
 {
-	if (first == last)
-		return {};
-	bool never_checked = true;
-	typename Iterator::value_type result = {};
-	for (; first != last; ++first) {
-		if (r.satisfies(*first)) {
-			if (never_checked) {
-				never_checked = false;
-				result = *first;
-			} else if (pred(*first, result)) {
-				result = *first;
-			}
-		}
-	}
-	return result;
+// AST of a range with the comparators of the versions, as if their texts, prefixed
+// by the operators, were parsed as one alternative.
+template <std::size_t N>
+std::vector<std::unique_ptr<node>> alternative(range_lexer::token t,
+	const std::pair<std::string_view, const semver *> (&comparators)[N])
+{
+	range_builder<> b;
+	b.reserve(2u * N, 1u);
+	for (const auto & [op, v] : comparators)
+		b.partial(t, parts_of(*v, op));
+	b.clause_end(N);
+	b.finish();
+	return b.ast();
+}
+}
+
+// Tightens the lower bound `b` by the bound `v`. An exclusive bound is tighter than
+// an inclusive one with the same version.
+template <typename Bound> void tighten_lower(Bound & b, const Bound & v) noexcept
+{
+	if (v.unbounded)
+		return;
+	if (b.unbounded || (b.version < v.version)
+		|| ((b.version == v.version) && b.inclusive && !v.inclusive))
+		b = v;
+}
+
+template <typename Bound> void tighten_upper(Bound & b, const Bound & v) noexcept
+{
+	if (v.unbounded)
+		return;
+	if (b.unbounded || (v.version < b.version)
+		|| ((b.version == v.version) && b.inclusive && !v.inclusive))
+		b = v;
+}
+
+// Widens the upper bound `b` to include the bound `v`.
+template <typename Bound> void widen_upper(Bound & b, const Bound & v) noexcept
+{
+	if (b.unbounded)
+		return;
+	if (v.unbounded || (b.version < v.version)
+		|| ((b.version == v.version) && !b.inclusive && v.inclusive))
+		b = v;
+}
+
+// Returns true if the lower bound `a` starts before the lower bound `b`.
+template <typename Bound> bool lower_less(const Bound & a, const Bound & b) noexcept
+{
+	if (b.unbounded)
+		return false;
+	if (a.unbounded)
+		return true;
+	if (a.version == b.version)
+		return a.inclusive && !b.inclusive;
+	return a.version < b.version;
+}
+
+template <typename V, typename Bound> bool above_lower(const V & v, const Bound & b) noexcept
+{
+	if (b.unbounded)
+		return true;
+	return precedes(b.version, v) || (b.inclusive && same_precedence(b.version, v));
+}
+
+template <typename V, typename Bound> bool below_upper(const V & v, const Bound & b) noexcept
+{
+	if (b.unbounded)
+		return true;
+	return precedes(v, b.version) || (b.inclusive && same_precedence(b.version, v));
+}
+
+template <typename Bound> bool is_empty(const Bound & lower, const Bound & upper) noexcept
+{
+	if (lower.unbounded || upper.unbounded)
+		return false;
+	if (lower.version == upper.version)
+		return !(lower.inclusive && upper.inclusive);
+	return upper.version < lower.version;
+}
+
+// Returns true if an interval ending with `upper` and one starting with `lower`,
+// not before the first one, overlap or touch each other.
+template <typename Bound> bool connected(const Bound & upper, const Bound & lower) noexcept
+{
+	if (upper.unbounded || lower.unbounded)
+		return true;
+	if (lower.version == upper.version)
+		return lower.inclusive || upper.inclusive;
+	return lower.version < upper.version;
 }
 }
 
 range::~range() { }
 
+range::range(const range & other)
+	: good_(other.good_)
+	, empty_(other.empty_)
+	, lower_(other.lower_)
+	, upper_(other.upper_)
+	, min_(other.min_)
+	, max_(other.max_)
+{
+	nodes_.reserve(other.nodes_.size());
+	for (const auto & n : other.nodes_)
+		nodes_.push_back(n->clone());
+}
+
+range & range::operator=(const range & other)
+{
+	if (this != &other)
+		*this = range(other);
+	return *this;
+}
+
+range::range(range &&) noexcept = default;
+range & range::operator=(range &&) noexcept = default;
+
 range::range(const std::string & s)
+	: range(s, range_limits {})
+{
+}
+
+range::range(std::vector<std::unique_ptr<detail::node>> && nodes)
+	: good_(true)
+	, nodes_(std::move(nodes))
+{
+	compute_bounds();
+}
+
+range::range(const std::string & s, const range_limits & limits)
 {
-	auto p = detail::range_parser(s);
+	[[maybe_unused]] const detail::latency_timer timer(latency::range_parse);
+
+	auto p = detail::range_parser(s, limits);
 	good_ = p.ok();
-	if (good_)
+	if (good_) {
 		nodes_ = p.ast();
+		compute_bounds();
+		detail::stats_range_parsed();
+	} else {
+		detail::stats_parse_failed(
+			p.limit_exceeded() ? parse_failure::range_limit : parse_failure::range_syntax);
+	}
+}
+
+range range::caret(const semver & v)
+{
+	if (!v.ok())
+		return range();
+	return range(detail::alternative(detail::range_lexer::token::caret_partial, {{"^", &v}}));
+}
+
+range range::tilde(const semver & v)
+{
+	if (!v.ok())
+		return range();
+	return range(detail::alternative(detail::range_lexer::token::tilde_partial, {{"~", &v}}));
+}
+
+range range::exact(const semver & v)
+{
+	if (!v.ok())
+		return range();
+	return range(detail::alternative(detail::range_lexer::token::op_partial, {{"=", &v}}));
+}
+
+range range::between(const semver & lo, const semver & hi, inclusivity i)
+{
+	if (!lo.ok() || !hi.ok())
+		return range();
+
+	const auto lower_open = (i == inclusivity::open) || (i == inclusivity::left_open);
+	const auto upper_open = (i == inclusivity::open) || (i == inclusivity::right_open);
+	return range(detail::alternative(detail::range_lexer::token::op_partial,
+		{{lower_open ? ">" : ">=", &lo}, {upper_open ? "<" : "<=", &hi}}));
+}
+
+range range::any_of(std::initializer_list<range> ranges)
+{
+	return any_of(ranges.begin(), ranges.end());
+}
+
+range range::any_of(const std::vector<range> & ranges)
+{
+	return any_of(ranges.data(), ranges.data() + ranges.size());
+}
+
+range range::any_of(const range * first, const range * last)
+{
+	if (first == last)
+		return range();
+
+	std::vector<std::unique_ptr<detail::node>> nodes;
+	for (auto r = first; r != last; ++r) {
+		if (!r->ok())
+			return range();
+		for (const auto & n : r->nodes_)
+			nodes.push_back(n->clone());
+	}
+	detail::sort_alternatives(nodes);
+	return range(std::move(nodes));
+}
+
+range range::all_of(std::initializer_list<range> ranges, const range_limits & limits)
+{
+	return all_of(ranges.begin(), ranges.end(), limits);
+}
+
+range range::all_of(const std::vector<range> & ranges, const range_limits & limits)
+{
+	return all_of(ranges.data(), ranges.data() + ranges.size(), limits);
+}
+
+range range::all_of(const range * first, const range * last, const range_limits & limits)
+{
+	if (first == last)
+		return range();
+
+	// sizes of the result: the product of the numbers of alternatives, and the
+	// sum of the largest numbers of leafs of an alternative of each range
+	std::size_t alternatives = 1u;
+	std::size_t comparators = 0u;
+	for (auto r = first; r != last; ++r) {
+		if (!r->ok())
+			return range();
+		if (r->nodes_.size() > limits.max_clauses / alternatives)
+			return range();
+		alternatives *= r->nodes_.size();
+
+		std::size_t leafs = 0u;
+		for (const auto & n : r->nodes_) {
+			std::size_t count = 0u;
+			n->visit_prefix([&count](const detail::node & c) { count += c.is_leaf() ? 1u : 0u; });
+			leafs = std::max(leafs, count);
+		}
+		if (leafs > limits.max_comparators - comparators)
+			return range();
+		comparators += leafs;
+	}
+
+	// every combination of one alternative of each range, in the order of the
+	// alternatives within the ranges, i.e. as formatted
+	std::vector<std::vector<const detail::node *>> clauses(1u);
+	for (auto r = first; r != last; ++r) {
+		std::vector<std::vector<const detail::node *>> next;
+		next.reserve(clauses.size() * r->nodes_.size());
+		for (const auto & c : clauses) {
+			for (const auto & n : r->nodes_) {
+				next.push_back(c);
+				next.back().push_back(n.get());
+			}
+		}
+		clauses = std::move(next);
+	}
+
+	std::vector<std::unique_ptr<detail::node>> nodes;
+	nodes.reserve(clauses.size());
+	for (const auto & c : clauses) {
+		if (c.size() == 1u) {
+			nodes.push_back(c.front()->clone());
+			continue;
+		}
+		std::vector<std::unique_ptr<detail::node>> v;
+		v.reserve(c.size());
+		for (const auto * n : c)
+			v.push_back(n->clone());
+		nodes.push_back(
+			std::make_unique<detail::node>(detail::node::create_and_of_leafs(std::move(v))));
+	}
+	detail::sort_alternatives(nodes);
+	return range(std::move(nodes));
 }
 
-semver range::max() const noexcept
+std::vector<std::pair<range::bound, range::bound>> range::intervals() const
 {
-	// Algorithm:
-	//
-	//   1. collect all min/max of 'or' nodes -> v_min, v_max
-	//
-	//   2. collect min/max from all 'and' nodes using (min|max)_satisfying, for all 'and':
-	//      - min = min_satisfying({local min})
-	//      - max = max_satisfying({local max})
-	//
-	//   3. determine min/max using (min|max)_satisfying from v_min/v_max and min/max from step
-	//   2
-	//
+	// Every alternative is an intersection of comparators, each of them an interval,
+	// therefore the alternative is an interval as well. The sorted and merged intervals
+	// of all alternatives describe exactly the versions satisfying the range.
 
-	std::vector<semver> v;
+	const auto leaf_bounds = [](const detail::node & n, bound & l, bound & u) {
+		using type = detail::node::type;
+		const auto & v = n.get_version();
+		switch (n.get_type()) {
+			case type::op_eq:
+				l = {v, true, false};
+				u = {v, true, false};
+				break;
+			case type::op_lt:
+				u = {v, false, false};
+				break;
+			case type::op_le:
+				u = {v, true, false};
+				break;
+			case type::op_gt:
+				l = {v, false, false};
+				break;
+			case type::op_ge:
+				l = {v, true, false};
+				break;
+			case type::op_and:
+			case type::op_or:
+				break;
+		}
+	};
+
+	using interval = std::pair<bound, bound>;
+	std::vector<interval> intervals;
+	intervals.reserve(nodes_.size());
 	for (const auto & n : nodes_) {
+		bound l;
+		bound u;
 		if (n->is_leaf()) {
-			v.emplace_back(upper_bound(*n));
+			leaf_bounds(*n, l, u);
 		} else {
-			std::vector<semver> local;
-			for (const auto & m : *n)
-				local.emplace_back(upper_bound(*m));
-			v.push_back(max_satisfying(local));
+			for (const auto & m : *n) {
+				bound ml;
+				bound mu;
+				leaf_bounds(*m, ml, mu);
+				detail::tighten_lower(l, ml);
+				detail::tighten_upper(u, mu);
+			}
 		}
+		if (!detail::is_empty(l, u))
+			intervals.emplace_back(std::move(l), std::move(u));
 	}
 
-	return max_satisfying(v);
+	if (intervals.empty())
+		return intervals;
+
+	std::sort(begin(intervals), end(intervals),
+		[](const auto & a, const auto & b) { return detail::lower_less(a.first, b.first); });
+
+	auto last = begin(intervals);
+	for (auto i = next(begin(intervals)); i != end(intervals); ++i) {
+		if (detail::connected(last->second, i->first)) {
+			detail::widen_upper(last->second, i->second);
+		} else {
+			++last;
+			if (last != i)
+				*last = std::move(*i);
+		}
+	}
+	intervals.erase(next(last), end(intervals));
+	return intervals;
 }
 
-semver range::min() const noexcept
+void range::compute_bounds()
 {
-	std::vector<semver> v;
+	const auto intervals = this->intervals();
+	empty_ = intervals.empty();
+	if (empty_)
+		return;
+
+	lower_ = intervals.front().first;
+	upper_ = intervals.back().second;
+
+	const auto contains = [&intervals](const semver & v) {
+		const auto i = std::partition_point(begin(intervals), end(intervals),
+			[&v](const auto & iv) { return detail::above_lower(v, iv.first); });
+		return (i != begin(intervals)) && detail::below_upper(v, prev(i)->second);
+	};
+
+	// min/max are the lowest/highest of the bounds of all comparators which
+	// satisfy the range.
+
+	bool min_found = false;
+	bool max_found = false;
+	const auto update = [&](const detail::node & m) {
+		const auto l = lower_bound(m);
+		if (l.ok() && (!min_found || (l < min_)) && contains(l)) {
+			min_found = true;
+			min_ = l;
+		}
+		const auto u = upper_bound(m);
+		if (u.ok() && (!max_found || (max_ < u)) && contains(u)) {
+			max_found = true;
+			max_ = u;
+		}
+	};
 	for (const auto & n : nodes_) {
 		if (n->is_leaf()) {
-			v.emplace_back(lower_bound(*n));
+			update(*n);
 		} else {
-			std::vector<semver> local;
 			for (const auto & m : *n)
-				local.emplace_back(lower_bound(*m));
-			v.push_back(min_satisfying(local));
+				update(*m);
 		}
 	}
+}
 
-	return min_satisfying(v);
+template <typename V> bool range::within_bounds(const V & v) const noexcept
+{
+	return !empty_ && detail::above_lower(v, lower_) && detail::below_upper(v, upper_);
+}
+
+template <typename V> bool range::eval(const V & v) const noexcept
+{
+	[[maybe_unused]] const detail::latency_timer timer(latency::satisfies);
+	std::uint64_t visited = 0u;
+	const auto visit = detail::node_visit(&visited);
+
+	// quick rejection of versions outside of all alternatives, all nodes
+	// in AST are implicit `or`
+	const bool result = within_bounds(v)
+		&& std::any_of(begin(nodes_), end(nodes_),
+			[&v, visit](const auto & n) { return n->eval(v, visit); });
+
+	detail::stats_satisfies(visited);
+	return result;
+}
+
+bool range::gtr(const semver & v) const noexcept
+{
+	return !empty_ && !detail::below_upper(v, upper_);
+}
+
+bool range::gtr(const semver_view & v) const noexcept
+{
+	return !empty_ && !detail::below_upper(v, upper_);
+}
+
+bool range::ltr(const semver & v) const noexcept
+{
+	return !empty_ && !detail::above_lower(v, lower_);
+}
+
+bool range::ltr(const semver_view & v) const noexcept
+{
+	return !empty_ && !detail::above_lower(v, lower_);
 }
 
 bool range::satisfies(const semver & v) const noexcept
 {
-	if (nodes_.empty())
-		return false;
+	return eval(v);
+}
 
-	// all nodes in AST are implicit `or`
-	for (const auto & n : nodes_)
-		if (n->eval(v))
-			return true;
+bool range::satisfies(const semver_view & v) const noexcept
+{
+	return v.ok() && eval(v);
+}
+
+bool range::satisfies(std::string_view s) const noexcept
+{
+	// the parser refers to the text, the core is compared first by the nodes,
+	// the prerelease only if the core equals the one of a comparator
+	const auto p = detail::semver_parser(s);
+	return p.ok() && eval(p);
+}
 
-	return false;
+bool range::satisfies(const version_tuple & v) const noexcept
+{
+	return eval(v);
 }
 
 semver range::max_satisfying(const std::vector<semver> & versions) const noexcept
 {
-	return detail::satisfies_if(*this, begin(versions), end(versions), std::greater<> {});
+	return max_satisfying(begin(versions), end(versions));
 }
 
 semver range::min_satisfying(const std::vector<semver> & versions) const noexcept
 {
-	return detail::satisfies_if(*this, begin(versions), end(versions), std::less<> {});
+	return min_satisfying(begin(versions), end(versions));
 }
 
-std::string to_string(const range & r)
+namespace detail
 {
-	std::string s;
+void format_range(const range & r, format_write write, void * context)
+{
+	const auto w = [write, context](const char * s, std::size_t n) { write(context, s, n); };
+
 	bool first = true;
 	for (const auto & n : r.nodes_) {
 		if (first) {
 			first = false;
 		} else {
-			s += " || ";
+			w(" || ", 4u);
 		}
 
-		s += to_string(*n);
+		format_node(*n, w);
 	}
+}
+}
 
+std::size_t formatted_size(const range & r) noexcept
+{
+	std::size_t size = 0u;
+	for (const auto & n : r.nodes_)
+		size += formatted_size(*n) + 4u;
+	return (size > 0u) ? size - 4u : 0u;
+}
+
+void append_to(std::string & out, const range & r)
+{
+	const auto size = out.size();
+	out.resize(size + formatted_size(r));
+	char * p = out.data() + size;
+	detail::format_range(
+		r,
+		[](void * context, const char * s, std::size_t n) {
+			auto & it = *static_cast<char **>(context);
+			it = std::copy(s, s + n, it);
+		},
+		&p);
+}
+
+std::string to_string(const range & r)
+{
+	std::string s;
+	append_to(s, r);
 	return s;
 }
 
 std::ostream & operator<<(std::ostream & os, const range & r)
 {
-	return os << to_string(r);
+	// a field width applies to the range as a whole
+	if (os.width() != 0)
+		return os << to_string(r);
+
+	detail::format_range(
+		r,
+		[](void * context, const char * s, std::size_t n) {
+			static_cast<std::ostream *>(context)->write(s, static_cast<std::streamsize>(n));
+		},
+		&os);
+	return os;
 }
 
 bool operator==(const range & r1, const range & r2) noexcept
@@ -0,0 +1,241 @@
+#include <semver/registry.hpp>
+#include <semver/sort.hpp>
+#include "detail/thread_list.hpp"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+namespace
+{
+// Epochs shared by all registries. A reading thread announces the epoch in which it
+// started reading, 0 while it does not read. A state replaced in epoch `e` can only
+// be read by threads which announced an epoch before `e`.
+struct reader {
+	std::atomic<std::uint64_t> epoch {0u};
+	unsigned int depth = 0u; // nested snapshots, only accessed by the thread
+	reader * prev = nullptr; // intrusive list of the readers of living threads
+	reader * next = nullptr;
+};
+
+struct epochs {
+	thread_list<reader> threads;
+	std::atomic<std::uint64_t> current {1u};
+
+	void leave(const reader &) noexcept {}
+};
+
+epochs & get_epochs()
+{
+	return static_instance<epochs>();
+}
+
+reader & local_reader()
+{
+	thread_local thread_registration<epochs> r;
+	return r.node;
+}
+
+void enter() noexcept
+{
+	auto & r = local_reader();
+	if (r.depth++ == 0u)
+		r.epoch.store(get_epochs().current.load());
+}
+
+void leave() noexcept
+{
+	auto & r = local_reader();
+	if (--r.depth == 0u)
+		r.epoch.store(0u, std::memory_order_release);
+}
+
+// Returns the lowest epoch announced by a reading thread.
+std::uint64_t oldest_reader() noexcept
+{
+	auto & e = get_epochs();
+	const std::lock_guard lock(e.threads.mutex);
+	auto result = std::numeric_limits<std::uint64_t>::max();
+	e.threads.for_each([&result](const reader & r) {
+		const auto epoch = r.epoch.load();
+		if (epoch != 0u)
+			result = std::min(result, epoch);
+	});
+	return result;
+}
+}
+}
+
+registry_snapshot::registry_snapshot(const detail::registry_state * state) noexcept
+	: state_(state)
+{
+}
+
+registry_snapshot::registry_snapshot(registry_snapshot && other) noexcept
+	: state_(other.state_)
+{
+	other.state_ = nullptr;
+}
+
+registry_snapshot::~registry_snapshot()
+{
+	if (state_)
+		detail::leave();
+}
+
+bool registry_snapshot::contains(const semver & v) const noexcept
+{
+	const auto & versions = state_->versions;
+	const auto i = std::lower_bound(begin(versions), end(versions), v);
+	return (i != end(versions)) && (*i == v);
+}
+
+semver registry_snapshot::max_satisfying(const range & r) const
+{
+	if (!r.ok())
+		return {};
+
+	// versions are sorted, all versions greater than the range are at the end
+	const auto & versions = state_->versions;
+	const auto last = std::partition_point(
+		begin(versions), end(versions), [&r](const semver & v) { return !r.gtr(v); });
+	for (auto i = last; i != begin(versions); --i) {
+		if (r.ltr(*std::prev(i)))
+			break;
+		if (r.satisfies(*std::prev(i)))
+			return *std::prev(i);
+	}
+	return {};
+}
+
+semver registry_snapshot::min_satisfying(const range & r) const
+{
+	if (!r.ok())
+		return {};
+
+	// versions are sorted, all versions less than the range are at the beginning
+	const auto & versions = state_->versions;
+	const auto first = std::partition_point(
+		begin(versions), end(versions), [&r](const semver & v) { return r.ltr(v); });
+	for (auto i = first; i != end(versions); ++i) {
+		if (r.gtr(*i))
+			break;
+		if (r.satisfies(*i))
+			return *i;
+	}
+	return {};
+}
+
+version_registry::version_registry()
+	: state_(new detail::registry_state)
+{
+}
+
+version_registry::version_registry(std::vector<semver> versions)
+	: version_registry()
+{
+	versions.erase(std::remove_if(begin(versions), end(versions),
+					   [](const semver & v) { return !v.ok(); }),
+		end(versions));
+	stable_sort(versions);
+	unique(versions);
+
+	auto state = std::make_unique<detail::registry_state>();
+	state->versions = std::move(versions);
+	delete state_.exchange(state.release());
+}
+
+version_registry::~version_registry()
+{
+	delete state_.load();
+}
+
+registry_snapshot version_registry::snapshot() const noexcept
+{
+	// the epoch is announced before the state is loaded, a writer replacing the
+	// state later will not reclaim it before the snapshot is gone
+	detail::enter();
+	return registry_snapshot(state_.load());
+}
+
+bool version_registry::publish(const semver & v)
+{
+	return update({v}, {}) == 1u;
+}
+
+bool version_registry::yank(const semver & v)
+{
+	return update({}, {v}) == 1u;
+}
+
+std::size_t version_registry::update(
+	const std::vector<semver> & published, const std::vector<semver> & yanked)
+{
+	const std::lock_guard lock(writer_);
+
+	// only the writer replaces the state, it can be read without announcing an epoch
+	const auto & current = *state_.load();
+	auto state = std::make_unique<detail::registry_state>();
+	auto & versions = state->versions;
+	versions = current.versions;
+	versions.reserve(versions.size() + published.size());
+
+	std::size_t changes = 0u;
+	for (const auto & v : published) {
+		if (!v.ok())
+			continue;
+		const auto i = std::lower_bound(begin(versions), end(versions), v);
+		if ((i != end(versions)) && (*i == v))
+			continue;
+		versions.insert(i, v);
+		++changes;
+	}
+	for (const auto & v : yanked) {
+		const auto i = std::lower_bound(begin(versions), end(versions), v);
+		if ((i == end(versions)) || (*i != v))
+			continue;
+		versions.erase(i);
+		++changes;
+	}
+
+	if (changes > 0u) {
+		state->generation = current.generation + 1u;
+		replace(std::move(state));
+	}
+	return changes;
+}
+
+void version_registry::replace(std::unique_ptr<detail::registry_state> state)
+{
+	const auto * old = state_.exchange(state.release());
+
+	// readers announcing this epoch or a later one load the new state
+	const auto epoch = detail::get_epochs().current.fetch_add(1u) + 1u;
+	retired_.emplace_back(epoch, old);
+	reclaim_locked();
+}
+
+std::size_t version_registry::reclaim()
+{
+	const std::lock_guard lock(writer_);
+	return reclaim_locked();
+}
+
+std::size_t version_registry::reclaim_locked()
+{
+	if (retired_.empty())
+		return 0u;
+
+	const auto oldest = detail::oldest_reader();
+	retired_.erase(std::remove_if(begin(retired_), end(retired_),
+					   [oldest](const auto & r) { return r.first <= oldest; }),
+		end(retired_));
+	return retired_.size();
+}
+}
+}
@@ -0,0 +1,217 @@
+#include <semver/sort.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <thread>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+namespace
+{
+// numerical core of a version and its position within the input
+struct sort_record {
+	semver::number_type core[3];
+	std::size_t index;
+};
+
+constexpr std::size_t radix_bits = 8u;
+constexpr std::size_t radix_size = 1u << radix_bits;
+constexpr std::size_t digits_per_number = sizeof(semver::number_type) * 8u / radix_bits;
+constexpr std::size_t digits = 3u * digits_per_number;
+
+// inputs smaller than this are not worth to be sorted in parallel
+constexpr std::size_t parallel_threshold = 1u << 15;
+
+// digit `d` counts from the least significant byte of patch to the most
+// significant byte of major.
+std::size_t digit(const sort_record & r, std::size_t d) noexcept
+{
+	const auto n = r.core[2u - d / digits_per_number];
+	return static_cast<std::size_t>(n >> ((d % digits_per_number) * radix_bits))
+		& (radix_size - 1u);
+}
+
+bool core_less(const sort_record & a, const sort_record & b) noexcept
+{
+	return std::lexicographical_compare(
+		std::begin(a.core), std::end(a.core), std::begin(b.core), std::end(b.core));
+}
+
+bool core_equal(const sort_record & a, const sort_record & b) noexcept
+{
+	return std::equal(std::begin(a.core), std::end(a.core), std::begin(b.core));
+}
+
+// LSD radix sort of the records by their numerical core, stable. Digits which are
+// the same for all records (e.g. the high bytes of small numbers) are skipped.
+void radix_sort(sort_record * first, sort_record * last, sort_record * buffer)
+{
+	const auto n = static_cast<std::size_t>(last - first);
+	if (n < 2u)
+		return;
+
+	std::vector<std::array<std::size_t, radix_size>> histogram(digits);
+	for (auto & h : histogram)
+		h.fill(0u);
+	for (auto i = first; i != last; ++i)
+		for (std::size_t d = 0; d < digits; ++d)
+			++histogram[d][digit(*i, d)];
+
+	sort_record * src = first;
+	sort_record * dst = buffer;
+	for (std::size_t d = 0; d < digits; ++d) {
+		auto & h = histogram[d];
+		if (std::any_of(h.begin(), h.end(), [n](auto c) { return c == n; }))
+			continue; // all records share this digit
+
+		std::size_t offset = 0u;
+		for (auto & c : h) {
+			const auto count = c;
+			c = offset;
+			offset += count;
+		}
+		for (auto i = src; i != src + n; ++i)
+			dst[h[digit(*i, d)]++] = *i;
+		std::swap(src, dst);
+	}
+	if (src != first)
+		std::copy(src, src + n, first);
+}
+
+// Sorts records of equal numerical core by the precedence of their prereleases.
+template <typename Sort>
+void sort_equal_cores(
+	sort_record * first, sort_record * last, const semver * versions, Sort sort_range)
+{
+	const auto less = [versions](const sort_record & a, const sort_record & b) {
+		return versions[a.index] < versions[b.index];
+	};
+
+	while (first != last) {
+		const auto run_end = std::find_if_not(
+			first + 1, last, [first](const sort_record & r) { return core_equal(*first, r); });
+		if (std::distance(first, run_end) > 1)
+			sort_range(first, run_end, less);
+		first = run_end;
+	}
+}
+
+template <typename Sort>
+void sort_records(sort_record * first, sort_record * last, sort_record * buffer,
+	const semver * versions, Sort sort_range)
+{
+	radix_sort(first, last, buffer);
+	sort_equal_cores(first, last, versions, sort_range);
+}
+
+template <typename Sort>
+void sort_records_parallel(std::vector<sort_record> & records, const semver * versions,
+	Sort sort_range, unsigned int threads)
+{
+	std::vector<sort_record> buffer(records.size());
+
+	// sort slices independently
+	const auto n = records.size();
+	std::vector<std::size_t> bounds;
+	for (unsigned int t = 0; t <= threads; ++t)
+		bounds.push_back(n * t / threads);
+
+	std::vector<std::thread> workers;
+	for (unsigned int t = 0; t < threads; ++t) {
+		workers.emplace_back([&, t] {
+			sort_records(records.data() + bounds[t], records.data() + bounds[t + 1],
+				buffer.data() + bounds[t], versions, sort_range);
+		});
+	}
+	for (auto & w : workers)
+		w.join();
+
+	// merge neighbouring slices pairwise, stable, until one is left
+	const auto less = [versions](const sort_record & a, const sort_record & b) {
+		if (!core_equal(a, b))
+			return core_less(a, b);
+		return versions[a.index] < versions[b.index];
+	};
+	while (bounds.size() > 2u) {
+		std::vector<std::size_t> merged;
+		workers.clear();
+		for (std::size_t i = 0; i + 1 < bounds.size(); i += 2) {
+			merged.push_back(bounds[i]);
+			if (i + 2 < bounds.size()) {
+				workers.emplace_back([&, i] {
+					std::merge(records.data() + bounds[i], records.data() + bounds[i + 1],
+						records.data() + bounds[i + 1], records.data() + bounds[i + 2],
+						buffer.data() + bounds[i], less);
+					std::copy(buffer.data() + bounds[i], buffer.data() + bounds[i + 2],
+						records.data() + bounds[i]);
+				});
+			}
+		}
+		merged.push_back(bounds.back());
+		for (auto & w : workers)
+			w.join();
+		bounds = std::move(merged);
+	}
+}
+
+template <typename Sort>
+void sort_versions(std::vector<semver>::iterator first, std::vector<semver>::iterator last,
+	execution policy, Sort sort_range)
+{
+	const auto n = static_cast<std::size_t>(std::distance(first, last));
+	if (n < 2u)
+		return;
+
+	const semver * versions = &*first;
+	std::vector<sort_record> records(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		const auto & v = versions[i];
+		records[i] = {{v.major(), v.minor(), v.patch()}, i};
+	}
+
+	// parallel execution was requested explicitly, use at least two threads
+	const auto threads = std::max(2u, std::thread::hardware_concurrency());
+	if ((policy == execution::parallel) && (n >= parallel_threshold)) {
+		sort_records_parallel(records, versions, sort_range, threads);
+	} else {
+		std::vector<sort_record> buffer(n);
+		sort_records(records.data(), records.data() + n, buffer.data(), versions, sort_range);
+	}
+
+	// apply permutation, versions are moved, not copied
+	std::vector<semver> sorted;
+	sorted.reserve(n);
+	for (const auto & r : records)
+		sorted.push_back(std::move(first[static_cast<std::ptrdiff_t>(r.index)]));
+	std::move(sorted.begin(), sorted.end(), first);
+}
+}
+}
+
+void sort(std::vector<semver>::iterator first, std::vector<semver>::iterator last,
+	execution policy)
+{
+	detail::sort_versions(first, last, policy,
+		[](auto b, auto e, auto less) { std::sort(b, e, less); });
+}
+
+void stable_sort(std::vector<semver>::iterator first, std::vector<semver>::iterator last,
+	execution policy)
+{
+	detail::sort_versions(first, last, policy,
+		[](auto b, auto e, auto less) { std::stable_sort(b, e, less); });
+}
+
+std::vector<semver>::iterator unique(
+	std::vector<semver>::iterator first, std::vector<semver>::iterator last)
+{
+	return std::unique(first, last);
+}
+}
+}
@@ -0,0 +1,154 @@
+#include <semver/statistics.hpp>
+#include "detail/statistics.hpp"
+
+#if defined(SEMVER_STATISTICS)
+	#include "detail/thread_list.hpp"
+	#include <algorithm>
+	#include <mutex>
+#endif
+
+namespace semver
+{
+inline namespace v1
+{
+#if defined(SEMVER_STATISTICS)
+namespace detail
+{
+namespace
+{
+using raw_counters = std::array<std::uint64_t, counter::count>;
+
+void accumulate(raw_counters & sum, const thread_counters & c) noexcept
+{
+	for (std::size_t i = 0u; i < counter::count; ++i)
+		sum[i] += c.values[i].load(std::memory_order_relaxed);
+}
+
+// Counters of all living threads, and the sums of finished threads.
+struct registry {
+	thread_list<thread_counters> threads;
+	raw_counters finished = {};
+	raw_counters baseline = {};
+	std::atomic<unsigned int> sampling {64u};
+
+	void leave(const thread_counters & c) noexcept { accumulate(finished, c); }
+};
+
+registry & get_registry()
+{
+	return static_instance<registry>();
+}
+
+// Returns the sums of all threads, the registry must be locked.
+raw_counters sum(const registry & r) noexcept
+{
+	auto result = r.finished;
+	r.threads.for_each([&result](const thread_counters & c) { accumulate(result, c); });
+	return result;
+}
+
+std::size_t bucket(std::uint64_t ns) noexcept
+{
+	std::size_t b = 0u;
+	for (ns >>= 1; (ns != 0u) && (b + 1u < latency_histogram::bucket_count); ns >>= 1)
+		++b;
+	return b;
+}
+}
+
+thread_counters & local_counters() noexcept
+{
+	thread_local thread_registration<registry> r;
+	return r.node;
+}
+
+bool sample_latency() noexcept
+{
+	const auto n = get_registry().sampling.load(std::memory_order_relaxed);
+	if (n == 0u)
+		return false;
+	auto & c = local_counters();
+	if (++c.sample_tick < n)
+		return false;
+	c.sample_tick = 0u;
+	return true;
+}
+
+void record_latency(latency l, std::chrono::steady_clock::duration d) noexcept
+{
+	const auto ns = static_cast<std::uint64_t>(
+		std::max<std::int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()));
+	const auto i = counter::latencies + static_cast<std::size_t>(l) * counter::latency_size;
+
+	auto & c = local_counters();
+	c.add(i + bucket(ns));
+	c.add(i + latency_histogram::bucket_count);
+	c.add(i + latency_histogram::bucket_count + 1u, ns);
+}
+}
+
+bool statistics_enabled() noexcept
+{
+	return true;
+}
+
+statistics statistics_snapshot() noexcept
+{
+	using namespace detail;
+
+	auto & r = get_registry();
+	raw_counters raw;
+	{
+		const std::lock_guard lock(r.threads.mutex);
+		raw = sum(r);
+		for (std::size_t i = 0u; i < counter::count; ++i)
+			raw[i] -= r.baseline[i];
+	}
+
+	statistics s;
+	s.versions_parsed = raw[counter::versions_parsed];
+	s.ranges_parsed = raw[counter::ranges_parsed];
+	for (std::size_t i = 0u; i < parse_failure_count; ++i)
+		s.parse_failures[i] = raw[counter::parse_failures + i];
+	s.satisfies_calls = raw[counter::satisfies_calls];
+	s.nodes_visited = raw[counter::nodes_visited];
+	s.comparisons = raw[counter::comparisons];
+	s.prerelease_comparisons = raw[counter::prerelease_comparisons];
+	for (std::size_t l = 0u; l < latency_count; ++l) {
+		const auto i = counter::latencies + l * counter::latency_size;
+		auto & h = s.latencies[l];
+		std::copy_n(begin(raw) + i, latency_histogram::bucket_count, begin(h.buckets));
+		h.samples = raw[i + latency_histogram::bucket_count];
+		h.total_ns = raw[i + latency_histogram::bucket_count + 1u];
+	}
+	return s;
+}
+
+void reset_statistics() noexcept
+{
+	auto & r = detail::get_registry();
+	const std::lock_guard lock(r.threads.mutex);
+	r.baseline = detail::sum(r);
+}
+
+void set_latency_sampling(unsigned int n) noexcept
+{
+	detail::get_registry().sampling.store(n, std::memory_order_relaxed);
+}
+#else
+bool statistics_enabled() noexcept
+{
+	return false;
+}
+
+statistics statistics_snapshot() noexcept
+{
+	return {};
+}
+
+void reset_statistics() noexcept {}
+
+void set_latency_sampling(unsigned int) noexcept {}
+#endif
+}
+}
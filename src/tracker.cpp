@@ -0,0 +1,181 @@
+#include <semver/tracker.hpp>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace semver
+{
+inline namespace v1
+{
+namespace detail
+{
+namespace
+{
+using number_type = semver::number_type;
+
+// Returns the first major number `m` with `pred(m)`, `pred` is false for all
+// numbers below it and true for all above, at least for the highest number.
+template <typename Predicate> number_type first_major(Predicate pred)
+{
+	number_type lo = 0u;
+	number_type hi = std::numeric_limits<number_type>::max();
+	while (lo < hi) {
+		const auto mid = lo + (hi - lo) / 2u;
+		if (pred(mid))
+			hi = mid;
+		else
+			lo = mid + 1u;
+	}
+	return lo;
+}
+
+void erase_id(std::vector<std::size_t> & ids, std::size_t id)
+{
+	const auto i = std::find(begin(ids), end(ids), id);
+	if (i != end(ids)) {
+		*i = ids.back();
+		ids.pop_back();
+	}
+}
+
+// Removes the id from the ids of the key, and the key if it has no ids left.
+template <typename Map, typename Key> void erase_id(Map & map, const Key & key, std::size_t id)
+{
+	const auto i = map.find(key);
+	if (i == map.end())
+		return;
+	erase_id(i->second, id);
+	if (i->second.empty())
+		map.erase(i);
+}
+}
+}
+
+std::size_t max_satisfying_tracker::subscribe(range r)
+{
+	constexpr auto max = std::numeric_limits<semver::number_type>::max();
+
+	const auto id = subscriptions_.size();
+	auto s = subscription {std::move(r), semver(), true, true, 0u, 0u};
+	if (!s.r.ok()) {
+		s.active = false;
+		subscriptions_.push_back(std::move(s));
+		return id;
+	}
+
+	// majors of the versions which are neither below nor above the range
+	const auto & rr = s.r;
+	const auto below = [&rr](semver::number_type m) { return !rr.ltr(semver(m, max, max)); };
+	const auto above = [&rr](semver::number_type m) { return rr.gtr(semver(m, 0u, 0u, "0")); };
+	if (below(max) && above(max)) {
+		s.first_major = detail::first_major(below);
+		const auto last = detail::first_major(above);
+		s.last_major = (last > 0u) ? last - 1u : 0u;
+		s.wide = (last == 0u) || (s.last_major < s.first_major)
+			|| (s.last_major - s.first_major >= max_indexed_majors);
+	}
+
+	if (s.wide) {
+		wide_.push_back(id);
+	} else {
+		for (auto m = s.first_major; m <= s.last_major; ++m)
+			by_major_[m].push_back(id);
+	}
+
+	const auto best = search(s.r, end(versions_));
+	subscriptions_.push_back(std::move(s));
+	set_best(id, best);
+	return id;
+}
+
+void max_satisfying_tracker::unsubscribe(std::size_t id)
+{
+	auto & s = subscriptions_[id];
+	if (!s.active)
+		return;
+	s.active = false;
+
+	if (s.wide) {
+		detail::erase_id(wide_, id);
+	} else {
+		for (auto m = s.first_major; m <= s.last_major; ++m)
+			detail::erase_id(by_major_, m, id);
+	}
+	if (s.best.ok())
+		detail::erase_id(by_best_, s.best, id);
+	s.best = semver();
+}
+
+std::vector<resolution_change> max_satisfying_tracker::publish(const semver & v)
+{
+	std::vector<resolution_change> changes;
+	if (!v.ok())
+		return changes;
+	const auto i = std::lower_bound(begin(versions_), end(versions_), v);
+	if ((i != end(versions_)) && (*i == v))
+		return changes;
+	versions_.insert(i, v);
+
+	const auto check = [&](std::size_t id) {
+		const auto & s = subscriptions_[id];
+		if ((!s.best.ok() || (s.best < v)) && s.r.satisfies(v)) {
+			changes.push_back({id, s.best, v});
+			set_best(id, v);
+		}
+	};
+	const auto m = by_major_.find(v.major());
+	if (m != by_major_.end()) {
+		for (const auto id : m->second)
+			check(id);
+	}
+	for (const auto id : wide_)
+		check(id);
+	return changes;
+}
+
+std::vector<resolution_change> max_satisfying_tracker::yank(const semver & v)
+{
+	std::vector<resolution_change> changes;
+	const auto i = std::lower_bound(begin(versions_), end(versions_), v);
+	if ((i == end(versions_)) || (*i != v))
+		return changes;
+	const auto position = versions_.erase(i);
+
+	const auto b = by_best_.find(v);
+	if (b == by_best_.end())
+		return changes;
+	const auto ids = std::move(b->second);
+	by_best_.erase(b);
+	for (const auto id : ids) {
+		auto & s = subscriptions_[id];
+		changes.push_back({id, s.best, search(s.r, position)});
+		s.best = semver();
+		set_best(id, changes.back().new_best);
+	}
+	return changes;
+}
+
+semver max_satisfying_tracker::search(
+	const range & r, std::vector<semver>::const_iterator last) const
+{
+	for (; last != begin(versions_); --last) {
+		const auto & v = *std::prev(last);
+		if (r.ltr(v))
+			break;
+		if (r.satisfies(v))
+			return v;
+	}
+	return {};
+}
+
+void max_satisfying_tracker::set_best(std::size_t id, const semver & v)
+{
+	auto & s = subscriptions_[id];
+	if (s.best.ok())
+		detail::erase_id(by_best_, s.best, id);
+	s.best = v;
+	if (v.ok())
+		by_best_[v].push_back(id);
+}
+}
+}
@@ -0,0 +1,166 @@
+#include <semver/allocation.hpp>
+#include <semver/range.hpp>
+#include <semver/registry.hpp>
+#include "detail/range_lexer.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace
+{
+using semver::allocation_scope;
+using semver::count_allocations;
+using semver::range;
+using semver::version_registry;
+using semver::semver;
+
+class test_allocation : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		if (!::semver::allocation_counting_enabled())
+			GTEST_SKIP() << "library built without ENABLE_ALLOCATION_COUNTING";
+	}
+};
+
+TEST_F(test_allocation, scope_counts_allocations)
+{
+	const auto scope = allocation_scope();
+	auto p = std::make_unique<int>(42);
+	const auto s = scope.stats();
+
+	EXPECT_EQ(1u, s.count);
+	EXPECT_EQ(sizeof(int), s.bytes);
+}
+
+TEST_F(test_allocation, nested_scopes)
+{
+	const auto outer = allocation_scope();
+	auto p1 = std::make_unique<int>(1);
+	const auto inner = allocation_scope();
+	auto p2 = std::make_unique<int>(2);
+
+	EXPECT_EQ(1u, inner.stats().count);
+	EXPECT_EQ(2u, outer.stats().count);
+}
+
+TEST_F(test_allocation, over_aligned)
+{
+	struct alignas(64) wide {
+		char data[64];
+	};
+
+	const auto scope = allocation_scope();
+	auto p1 = std::make_unique<wide>();
+	auto p2 = std::make_unique<wide[]>(3);
+	const auto s = scope.stats();
+
+	EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(p1.get()) % 64u);
+	EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(p2.get()) % 64u);
+	EXPECT_EQ(2u, s.count);
+	EXPECT_GE(s.bytes, 4u * sizeof(wide));
+}
+
+TEST_F(test_allocation, semver_plain)
+{
+	const auto s = count_allocations([] { semver("1.2.3"); });
+
+	EXPECT_EQ(0u, s.count);
+}
+
+TEST_F(test_allocation, semver_prerelease_and_build)
+{
+	const auto s = count_allocations([] { semver("1.2.3-alpha.beta.gamma+build.12345678"); });
+
+	EXPECT_LE(s.count, 4u);
+}
+
+TEST_F(test_allocation, semver_numerical)
+{
+	const auto s = count_allocations([] { semver(1, 2, 3); });
+
+	EXPECT_EQ(0u, s.count);
+}
+
+TEST_F(test_allocation, semver_compare)
+{
+	const auto a = semver("1.2.3-alpha.1");
+	const auto b = semver("1.2.3-alpha.2");
+	const auto s = count_allocations([&] { (void)(a < b); });
+
+	EXPECT_EQ(0u, s.count);
+}
+
+TEST_F(test_allocation, range_lexer)
+{
+	using lexer = ::semver::detail::range_lexer;
+
+	const std::string s = ">=1.2.3-alpha.beta.gamma <2.0.0 || ^3.x.x-some.long.prerelease";
+	const auto stats = count_allocations([&] {
+		lexer l(s);
+		while (l.scan() != lexer::token::eof)
+			;
+	});
+
+	EXPECT_EQ(0u, stats.count);
+}
+
+TEST_F(test_allocation, range_construction)
+{
+	const auto s = count_allocations([] { range(">=1.2.3 <2.0.0 || 3.0.0"); });
+
+	EXPECT_LE(s.count, 10u);
+}
+
+TEST_F(test_allocation, range_min_max)
+{
+	const auto r = range(">=1.2.3 <2.0.0 || 3.0.0");
+
+	EXPECT_EQ(0u, count_allocations([&] { r.min(); }).count);
+	EXPECT_EQ(0u, count_allocations([&] { r.max(); }).count);
+}
+
+TEST_F(test_allocation, range_satisfies)
+{
+	const auto r = range(">=1.2.3 <2.0.0 || 3.0.0");
+	const auto v = semver("1.5.0");
+	const auto s = count_allocations([&] { r.satisfies(v); });
+
+	EXPECT_EQ(0u, s.count);
+}
+
+TEST_F(test_allocation, range_satisfies_text)
+{
+	const auto r = range(">=1.2.3-alpha.1 <2.0.0 || 3.0.0");
+	const auto s = count_allocations([&] {
+		r.satisfies(std::string_view("1.2.3-alpha.beta.gamma.delta.epsilon+build.12345678"));
+		r.satisfies(std::string_view("1.5.0"));
+		r.satisfies(std::string_view("foo"));
+	});
+
+	EXPECT_EQ(0u, s.count);
+}
+
+TEST_F(test_allocation, range_satisfies_numbers)
+{
+	const auto r = range(">=1.2.3-alpha.1 <2.0.0 || 3.0.0");
+	const auto s = count_allocations([&] {
+		r.satisfies(1, 5, 0);
+		r.satisfies(1, 2, 3, "alpha.beta.gamma.delta.epsilon");
+	});
+
+	EXPECT_EQ(0u, s.count);
+}
+
+TEST_F(test_allocation, registry_first_snapshot_of_thread)
+{
+	const auto reg = version_registry({semver("1.0.0")});
+	std::size_t count = 1u;
+	std::thread([&reg, &count] { count = count_allocations([&reg] { reg.snapshot(); }).count; })
+		.join();
+
+	EXPECT_EQ(0u, count);
+}
+}
@@ -0,0 +1,206 @@
+#include <semver/binary.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+
+namespace
+{
+using semver::range;
+using semver::range_view;
+using semver::semver_view;
+using semver::semver;
+
+class test_binary : public ::testing::Test {};
+
+TEST_F(test_binary, header)
+{
+	std::string buf;
+	::semver::encode_header(buf);
+
+	EXPECT_EQ(::semver::binary_header_size, buf.size());
+	EXPECT_EQ(::semver::binary_format_version, ::semver::decode_header(buf));
+}
+
+TEST_F(test_binary, header_invalid)
+{
+	EXPECT_EQ(0u, ::semver::decode_header(""));
+	EXPECT_EQ(0u, ::semver::decode_header("SVB"));
+	EXPECT_EQ(0u, ::semver::decode_header("XYZ\x01"));
+}
+
+TEST_F(test_binary, semver_compact)
+{
+	std::string buf;
+
+	ASSERT_TRUE(::semver::encode(semver("1.2.3"), buf));
+
+	EXPECT_EQ(std::string("\x01\x02\x03\x00\x00", 5), buf);
+}
+
+TEST_F(test_binary, semver_roundtrip)
+{
+	constexpr auto max = std::numeric_limits<semver::number_type>::max();
+	const semver versions[] = {semver("0.0.0"), semver("1.2.3"), semver("128.16384.300"),
+		semver("1.2.3-alpha.1"), semver("1.2.3+build.5"), semver("1.2.3-rc.1+build-7"),
+		semver(max, max, max)};
+
+	for (const auto & v : versions) {
+		std::string buf;
+		ASSERT_TRUE(::semver::encode(v, buf));
+
+		const auto view = semver_view(buf);
+		ASSERT_TRUE(view.ok()) << v;
+		EXPECT_EQ(buf.size(), view.size());
+		EXPECT_EQ(v.major(), view.major());
+		EXPECT_EQ(v.minor(), view.minor());
+		EXPECT_EQ(v.patch(), view.patch());
+		EXPECT_EQ(v.prerelease(), view.prerelease());
+		EXPECT_EQ(v.build(), view.build());
+
+		const auto d = view.to_semver();
+		EXPECT_TRUE(d.ok());
+		EXPECT_EQ(v, d);
+		EXPECT_EQ(v.str(), d.str());
+	}
+}
+
+TEST_F(test_binary, semver_invalid_not_encoded)
+{
+	std::string buf;
+
+	EXPECT_FALSE(::semver::encode(semver("foo"), buf));
+	EXPECT_TRUE(buf.empty());
+}
+
+TEST_F(test_binary, semver_view_is_zero_copy)
+{
+	std::string buf;
+	ASSERT_TRUE(::semver::encode(semver("1.2.3-alpha+b1"), buf));
+
+	const auto view = semver_view(buf);
+
+	ASSERT_TRUE(view.ok());
+	EXPECT_GE(view.prerelease().data(), buf.data());
+	EXPECT_LT(view.prerelease().data(), buf.data() + buf.size());
+}
+
+TEST_F(test_binary, semver_truncated)
+{
+	std::string buf;
+	ASSERT_TRUE(::semver::encode(semver("1000.2.3-alpha+b1"), buf));
+
+	for (std::size_t n = 0u; n < buf.size(); ++n)
+		EXPECT_FALSE(semver_view(std::string_view(buf).substr(0u, n)).ok()) << n;
+}
+
+TEST_F(test_binary, semver_number_overflow)
+{
+	// 2^70, does not fit into a 64 bit number
+	const std::string buf("\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x01\x00\x00\x00\x00", 15);
+
+	EXPECT_FALSE(semver_view(buf).ok());
+}
+
+TEST_F(test_binary, semver_view_comparison)
+{
+	std::string buf;
+	ASSERT_TRUE(::semver::encode(semver("1.2.3-beta.2"), buf));
+	const auto view = semver_view(buf);
+
+	EXPECT_TRUE(view == semver("1.2.3-beta.2+b"));
+	EXPECT_TRUE(view < semver("1.2.3-beta.11"));
+	EXPECT_TRUE(semver("1.2.3-beta") < view);
+	EXPECT_FALSE(view < semver("1.2.3-beta.2"));
+}
+
+TEST_F(test_binary, sequence_of_versions)
+{
+	std::string buf;
+	::semver::encode_header(buf);
+	ASSERT_TRUE(::semver::encode(semver("1.0.0"), buf));
+	ASSERT_TRUE(::semver::encode(semver("2.0.0-rc.1"), buf));
+	ASSERT_TRUE(::semver::encode(semver("3.0.0"), buf));
+
+	std::string_view data(buf);
+	ASSERT_EQ(::semver::binary_format_version, ::semver::decode_header(data));
+	data.remove_prefix(::semver::binary_header_size);
+
+	std::vector<semver> v;
+	while (!data.empty()) {
+		const auto view = semver_view(data);
+		ASSERT_TRUE(view.ok());
+		v.push_back(view.to_semver());
+		data.remove_prefix(view.size());
+	}
+
+	EXPECT_EQ((std::vector<semver> {semver("1.0.0"), semver("2.0.0-rc.1"), semver("3.0.0")}), v);
+}
+
+TEST_F(test_binary, range_roundtrip)
+{
+	const char * ranges[] = {"", "*", "1.2.3", ">=1.2.3 <2.0.0", "^1.2.3 || ~2.4.0-beta.1",
+		">1.0.0 <=1.5.0 || =3.0.0 || <0.1.0", "1.x || >=4.0.0-rc.1"};
+
+	for (const auto s : ranges) {
+		const auto r = range(s);
+		ASSERT_TRUE(r.ok()) << s;
+
+		std::string buf;
+		ASSERT_TRUE(::semver::encode(r, buf)) << s;
+
+		const auto view = range_view(buf);
+		ASSERT_TRUE(view.ok()) << s;
+		EXPECT_EQ(buf.size(), view.size());
+
+		const auto d = view.to_range();
+		ASSERT_TRUE(d.ok()) << s;
+		EXPECT_EQ(r, d) << s;
+		EXPECT_EQ(to_string(r), to_string(d)) << s;
+		EXPECT_EQ(r.min(), d.min()) << s;
+		EXPECT_EQ(r.max(), d.max()) << s;
+	}
+}
+
+TEST_F(test_binary, range_view_satisfies)
+{
+	const char * ranges[] = {"^1.2.3 || ~2.4.0-beta.1", ">1.0.0 <=1.5.0 || =3.0.0",
+		"<1.0.0-0", "1.2.x"};
+	const semver versions[] = {semver("0.9.0"), semver("1.0.0"), semver("1.2.3"),
+		semver("1.2.9"), semver("1.5.0"), semver("1.9.0-alpha"), semver("2.0.0"),
+		semver("2.4.0-beta.0"), semver("2.4.0-beta.2"), semver("2.4.9"), semver("3.0.0"),
+		semver("1.0.0-rc.1")};
+
+	for (const auto s : ranges) {
+		const auto r = range(s);
+		std::string buf;
+		ASSERT_TRUE(::semver::encode(r, buf)) << s;
+		const auto view = range_view(buf);
+		ASSERT_TRUE(view.ok());
+
+		for (const auto & v : versions)
+			EXPECT_EQ(r.satisfies(v), view.satisfies(v)) << s << " " << v;
+	}
+}
+
+TEST_F(test_binary, range_invalid_not_encoded)
+{
+	std::string buf;
+
+	EXPECT_FALSE(::semver::encode(range("foo"), buf));
+	EXPECT_TRUE(buf.empty());
+	EXPECT_FALSE(range_view(buf).ok());
+	EXPECT_FALSE(range_view().to_range().ok());
+}
+
+TEST_F(test_binary, range_corrupted)
+{
+	std::string buf;
+	ASSERT_TRUE(::semver::encode(range(">=1.2.3 <2.0.0"), buf));
+
+	for (std::size_t n = 0u; n < buf.size(); ++n)
+		EXPECT_FALSE(range_view(std::string_view(buf).substr(0u, n)).ok()) << n;
+
+	auto bad_op = buf;
+	bad_op[2] = '\x7f';
+	EXPECT_FALSE(range_view(bad_op).ok());
+}
+}
@@ -0,0 +1,229 @@
+#include <semver/catalog.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+
+namespace
+{
+using semver::catalog;
+using semver::catalog_builder;
+using semver::catalog_versions;
+using semver::range;
+using semver::semver_view;
+using semver::semver;
+
+class test_catalog : public ::testing::Test
+{
+protected:
+	static std::vector<semver> to_semvers(const std::vector<semver_view> & views)
+	{
+		std::vector<semver> v;
+		for (const auto & view : views)
+			v.push_back(view.to_semver());
+		return v;
+	}
+
+	static std::string sample()
+	{
+		catalog_builder b;
+		b.add("foo", semver("1.2.3"));
+		b.add("foo", semver("1.0.0"));
+		b.add("foo", semver("2.0.0"));
+		b.add("foo", semver("1.2.4-beta.1"));
+		b.add("foo", semver("1.9.9"));
+		b.add("foo", semver("1.2.3"));
+		b.add("bar", semver("0.1.0"));
+		b.add("@scope/baz", semver("3.0.0+build.1"));
+		return b.build();
+	}
+};
+
+TEST_F(test_catalog, empty)
+{
+	const auto data = catalog_builder().build();
+	const auto c = catalog(data);
+
+	ASSERT_TRUE(c.ok());
+	EXPECT_EQ(0u, c.size());
+	EXPECT_TRUE(c.versions("foo").empty());
+}
+
+TEST_F(test_catalog, packages_sorted)
+{
+	const auto data = sample();
+	const auto c = catalog(data);
+
+	ASSERT_TRUE(c.ok());
+	ASSERT_EQ(3u, c.size());
+	EXPECT_EQ("@scope/baz", c.package(0));
+	EXPECT_EQ("bar", c.package(1));
+	EXPECT_EQ("foo", c.package(2));
+	EXPECT_EQ("", c.package(3));
+}
+
+TEST_F(test_catalog, versions_sorted_and_unique)
+{
+	const auto data = sample();
+	const auto versions = catalog(data).versions("foo");
+
+	ASSERT_EQ(5u, versions.size());
+	EXPECT_TRUE(versions[0] == semver("1.0.0"));
+	EXPECT_TRUE(versions[1] == semver("1.2.3"));
+	EXPECT_TRUE(versions[2] == semver("1.2.4-beta.1"));
+	EXPECT_TRUE(versions[3] == semver("1.9.9"));
+	EXPECT_TRUE(versions[4] == semver("2.0.0"));
+	EXPECT_FALSE(versions[5].ok());
+}
+
+TEST_F(test_catalog, unknown_package)
+{
+	const auto data = sample();
+	const auto c = catalog(data);
+
+	EXPECT_TRUE(c.versions("baz").empty());
+	EXPECT_TRUE(c.versions("").empty());
+	EXPECT_TRUE(c.versions("zzz").empty());
+}
+
+TEST_F(test_catalog, build_metadata_preserved)
+{
+	const auto data = sample();
+	const auto versions = catalog(data).versions("@scope/baz");
+
+	ASSERT_EQ(1u, versions.size());
+	EXPECT_EQ("build.1", versions[0].build());
+}
+
+TEST_F(test_catalog, interleaved_builds_unique)
+{
+	catalog_builder b;
+	b.add("foo", semver("1.0.0+a"));
+	b.add("foo", semver("1.0.0+b"));
+	b.add("foo", semver("1.0.0+a"));
+	b.add("foo", semver("1.0.0"));
+	b.add("foo", semver("1.0.0+b"));
+	const auto data = b.build();
+	const auto versions = catalog(data).versions("foo");
+
+	ASSERT_EQ(3u, versions.size());
+	EXPECT_EQ("", versions[0].build());
+	EXPECT_EQ("a", versions[1].build());
+	EXPECT_EQ("b", versions[2].build());
+}
+
+TEST_F(test_catalog, max_min_satisfying)
+{
+	const auto data = sample();
+	const auto versions = catalog(data).versions("foo");
+
+	EXPECT_TRUE(versions.max_satisfying(range("^1.2.0")) == semver("1.9.9"));
+	EXPECT_TRUE(versions.min_satisfying(range("^1.2.0")) == semver("1.2.3"));
+	EXPECT_TRUE(versions.max_satisfying(range("*")) == semver("2.0.0"));
+	EXPECT_TRUE(versions.min_satisfying(range("*")) == semver("1.0.0"));
+	EXPECT_TRUE(versions.max_satisfying(range("<1.2.4")) == semver("1.2.4-beta.1"));
+	EXPECT_FALSE(versions.max_satisfying(range(">2.0.0")).ok());
+	EXPECT_FALSE(versions.min_satisfying(range("<1.0.0")).ok());
+	EXPECT_FALSE(versions.max_satisfying(range("foo")).ok());
+}
+
+TEST_F(test_catalog, satisfying)
+{
+	const auto data = sample();
+	const auto versions = catalog(data).versions("foo");
+
+	EXPECT_EQ((std::vector<semver> {semver("1.2.3"), semver("1.2.4-beta.1"), semver("1.9.9")}),
+		to_semvers(versions.satisfying(range("^1.2.0"))));
+	EXPECT_EQ((std::vector<semver> {semver("1.0.0"), semver("2.0.0")}),
+		to_semvers(versions.satisfying(range("1.0.0 || >=2"))));
+	EXPECT_TRUE(versions.satisfying(range("3.x")).empty());
+}
+
+TEST_F(test_catalog, differential)
+{
+	std::mt19937 gen(7);
+	std::uniform_int_distribution<semver::number_type> number(0u, 5u);
+	std::uniform_int_distribution<int> pre(0, 3);
+
+	catalog_builder b;
+	std::vector<semver> all;
+	for (int i = 0; i < 2000; ++i) {
+		const auto v = (pre(gen) == 0)
+			? semver(number(gen), number(gen), number(gen), "rc." + std::to_string(pre(gen)))
+			: semver(number(gen), number(gen), number(gen));
+		all.push_back(v);
+		b.add("pkg", v);
+	}
+	const auto data = b.build();
+	const auto versions = catalog(data).versions("pkg");
+
+	for (const auto s : {"^1.2.0", "~3.4.0", ">=2.0.0-rc.1 <4.0.0", "1.x || 5.x", "<0.0.3",
+			 ">5.5.5", "=2.3.4-rc.2", "*"}) {
+		const auto r = range(s);
+		const auto max = r.max_satisfying(all);
+		const auto min = r.min_satisfying(all);
+		EXPECT_EQ(max.ok(), versions.max_satisfying(r).ok()) << s;
+		EXPECT_EQ(min.ok(), versions.min_satisfying(r).ok()) << s;
+		if (max.ok()) {
+			EXPECT_TRUE(versions.max_satisfying(r) == max) << s;
+		}
+		if (min.ok()) {
+			EXPECT_TRUE(versions.min_satisfying(r) == min) << s;
+		}
+
+		std::vector<semver> expected;
+		std::copy_if(begin(all), end(all), std::back_inserter(expected),
+			[&r](const auto & v) { return r.satisfies(v); });
+		std::sort(begin(expected), end(expected));
+		expected.erase(std::unique(begin(expected), end(expected)), end(expected));
+		EXPECT_EQ(expected, to_semvers(versions.satisfying(r))) << s;
+	}
+}
+
+TEST_F(test_catalog, invalid_data)
+{
+	const auto data = sample();
+
+	EXPECT_FALSE(catalog("").ok());
+	EXPECT_FALSE(catalog("SVC").ok());
+	EXPECT_FALSE(catalog(std::string_view(data).substr(0u, data.size() / 2u)).ok());
+
+	auto wrong_version = data;
+	wrong_version[3] = '\x7f';
+	EXPECT_FALSE(catalog(wrong_version).ok());
+}
+
+TEST_F(test_catalog, truncated_block)
+{
+	const auto r = range("*");
+
+	const auto none = catalog_versions(std::string_view("ab"), 5u);
+	EXPECT_TRUE(none.empty());
+	EXPECT_FALSE(none[0u].ok());
+	EXPECT_FALSE(none.max_satisfying(r).ok());
+	EXPECT_TRUE(none.satisfying(r).empty());
+
+	// room for the offset of one version, the others are missing
+	const auto one = catalog_versions(std::string_view("\x00\x00\x00\x00" "x", 5u), 3u);
+	EXPECT_EQ(1u, one.size());
+	EXPECT_FALSE(one[1u].ok());
+}
+
+TEST_F(test_catalog, file)
+{
+	const auto path = ::testing::TempDir() + "test_catalog.svc";
+
+	catalog_builder b;
+	b.add("foo", semver("1.2.3"));
+	b.add("foo", semver("1.3.0"));
+	ASSERT_TRUE(b.write(path));
+
+	{
+		const auto f = ::semver::catalog_file(path);
+		ASSERT_TRUE(f.ok());
+		EXPECT_TRUE(f.get().versions("foo").max_satisfying(range("~1.2")) == semver("1.2.3"));
+	}
+	std::remove(path.c_str());
+
+	EXPECT_FALSE(::semver::catalog_file(path).ok());
+}
+}
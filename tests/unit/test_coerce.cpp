@@ -0,0 +1,125 @@
+#include <semver/coerce.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace
+{
+using semver::coerce;
+using semver::coerce_all;
+using semver::coerce_options;
+using semver::semver;
+
+class test_coerce : public ::testing::Test
+{
+protected:
+	static constexpr coerce_options with_prerelease = {true};
+};
+
+TEST_F(test_coerce, first_version)
+{
+	EXPECT_EQ(semver("1.2.3"), coerce("release-v1.2.3-final.tar.gz"));
+	EXPECT_EQ(semver("1.2.3"), coerce("1.2.3"));
+	EXPECT_EQ(semver("1.2.0"), coerce("v1.2"));
+	EXPECT_EQ(semver("2.0.0"), coerce("version 2"));
+	EXPECT_EQ(semver("42.6.7"), coerce("42.6.7.9.3-alpha"));
+	EXPECT_EQ(semver("1.2.3"), coerce("  1.2.3  4.5.6"));
+	EXPECT_EQ(semver("0.0.0"), coerce("v0"));
+}
+
+TEST_F(test_coerce, no_version)
+{
+	EXPECT_FALSE(coerce("").ok());
+	EXPECT_FALSE(coerce("no version here").ok());
+	EXPECT_FALSE(coerce(".....").ok());
+	EXPECT_FALSE(coerce("12345678901234567").ok());
+}
+
+TEST_F(test_coerce, number_length)
+{
+	EXPECT_EQ(semver("1234567890123456.0.0"), coerce("1234567890123456"));
+	EXPECT_EQ(semver("1.0.0"), coerce("1.12345678901234567"));
+	EXPECT_EQ(semver("1.2.0"), coerce("1.2.12345678901234567"));
+	EXPECT_EQ(semver("2.0.0"), coerce("12345678901234567 2"));
+}
+
+TEST_F(test_coerce, prerelease_ignored_by_default)
+{
+	const auto v = coerce("1.2.3-rc.1+build.7");
+
+	EXPECT_EQ(semver("1.2.3"), v);
+	EXPECT_EQ("", v.prerelease());
+	EXPECT_EQ("", v.build());
+}
+
+TEST_F(test_coerce, prerelease)
+{
+	EXPECT_EQ("1.2.3-final.tar.gz", coerce("release-v1.2.3-final.tar.gz", with_prerelease).str());
+	EXPECT_EQ("1.2.3-rc.1+build.7", coerce("v1.2.3-rc.1+build.7!", with_prerelease).str());
+	EXPECT_EQ("1.2.3+001", coerce("1.2.3+001", with_prerelease).str());
+	EXPECT_EQ("1.0.0-beta", coerce("1-beta.", with_prerelease).str());
+	EXPECT_EQ("1.2.3-rc", coerce("1.2.3-rc.01", with_prerelease).str());
+	EXPECT_EQ("1.2.3", coerce("1.2.3-", with_prerelease).str());
+	EXPECT_EQ("1.2.3", coerce("1.2.3-01", with_prerelease).str());
+}
+
+TEST_F(test_coerce, all_versions)
+{
+	const std::string text = "deps: foo@1.2.3, bar@v10.0 and baz 7; see also 2.0.0-rc.1\n";
+	const auto m = coerce_all(text);
+
+	ASSERT_EQ(4u, m.size());
+	EXPECT_EQ("1.2.3", m[0].text);
+	EXPECT_EQ("10.0", m[1].text);
+	EXPECT_EQ("7", m[2].text);
+	EXPECT_EQ("2.0.0", m[3].text);
+	EXPECT_EQ(semver("10.0.0"), m[1].to_semver());
+	EXPECT_EQ(semver("7.0.0"), m[2].to_semver());
+}
+
+TEST_F(test_coerce, spans_refer_to_text)
+{
+	const std::string text = "a 1.2.3-rc.1+b b 4.5.6";
+	const auto m = coerce_all(text, with_prerelease);
+
+	ASSERT_EQ(2u, m.size());
+	EXPECT_EQ(text.data() + 2, m[0].text.data());
+	EXPECT_EQ("1.2.3-rc.1+b", m[0].text);
+	EXPECT_EQ(text.data() + 5, m[0].text.data() + 3);
+	EXPECT_EQ("rc.1", m[0].prerelease);
+	EXPECT_EQ("b", m[0].build);
+	EXPECT_EQ(text.data() + text.size() - 5, m[1].text.data());
+	EXPECT_EQ(semver("4.5.6"), m[1].to_semver());
+}
+
+TEST_F(test_coerce, scanner)
+{
+	::semver::coerce_scanner scanner("x1y22z333");
+	::semver::coerce_match m;
+
+	ASSERT_TRUE(scanner.next(m));
+	EXPECT_EQ(1u, m.major);
+	ASSERT_TRUE(scanner.next(m));
+	EXPECT_EQ(22u, m.major);
+	ASSERT_TRUE(scanner.next(m));
+	EXPECT_EQ(333u, m.major);
+	EXPECT_FALSE(scanner.next(m));
+	EXPECT_FALSE(scanner.next(m));
+}
+
+TEST_F(test_coerce, large_text)
+{
+	// the version is placed at every offset relative to the words being skipped
+	for (std::size_t n = 0; n < 24; ++n) {
+		const auto text = std::string(n, 'x') + "1.22.333" + std::string(n, '\x9f');
+		const auto m = coerce_all(text);
+
+		ASSERT_EQ(1u, m.size()) << n;
+		EXPECT_EQ(semver("1.22.333"), m[0].to_semver()) << n;
+		EXPECT_EQ(n, static_cast<std::size_t>(m[0].text.data() - text.data())) << n;
+	}
+
+	std::string text(1u << 20, '.');
+	text.replace(text.size() - 6u, 5u, "3.4.5");
+	EXPECT_EQ(semver("3.4.5"), coerce(text));
+}
+}
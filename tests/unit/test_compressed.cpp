@@ -0,0 +1,186 @@
+#include <semver/compressed.hpp>
+#include <semver/sort.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+using semver::compressed_versions;
+using semver::range;
+using semver::semver;
+
+class test_compressed : public ::testing::Test
+{
+protected:
+	// History of a package: releases with runs of patches, some with prereleases.
+	static std::vector<semver> history(std::size_t n)
+	{
+		std::vector<semver> result;
+		unsigned long major = 0u;
+		unsigned long minor = 1u;
+		unsigned long patch = 0u;
+		for (std::size_t i = 0u; result.size() < n; ++i) {
+			if ((i % 97u) == 96u) {
+				++major;
+				minor = 0u;
+				patch = 0u;
+				for (const auto * p : {"alpha.1", "alpha.2", "beta.1", "rc.1"})
+					result.push_back(semver(major, minor, patch, p));
+			} else if ((i % 11u) == 10u) {
+				++minor;
+				patch = 0u;
+			} else {
+				++patch;
+			}
+			result.push_back(semver(major, minor, patch));
+		}
+		result.resize(n);
+		return result;
+	}
+
+	static std::vector<semver> decode(const compressed_versions & c)
+	{
+		return std::vector<semver>(c.begin(), c.end());
+	}
+
+	static void expect_same(const std::vector<semver> & a, const std::vector<semver> & b)
+	{
+		ASSERT_EQ(a.size(), b.size());
+		for (std::size_t i = 0u; i < a.size(); ++i) {
+			EXPECT_EQ(a[i], b[i]) << i;
+			EXPECT_EQ(a[i].build(), b[i].build()) << i;
+		}
+	}
+};
+
+TEST_F(test_compressed, default_constructed)
+{
+	const auto c = compressed_versions();
+	EXPECT_FALSE(c.ok());
+	EXPECT_TRUE(c.empty());
+	EXPECT_TRUE(c.begin() == c.end());
+	EXPECT_FALSE(c.max_satisfying(range("*")).ok());
+}
+
+TEST_F(test_compressed, empty)
+{
+	const auto c = compressed_versions(std::vector<semver> {});
+	EXPECT_TRUE(c.ok());
+	EXPECT_EQ(0u, c.size());
+	EXPECT_TRUE(c.begin() == c.end());
+	EXPECT_FALSE(c.min_satisfying(range("*")).ok());
+}
+
+TEST_F(test_compressed, not_sorted)
+{
+	EXPECT_FALSE(compressed_versions({semver("1.0.0"), semver("0.9.0")}).ok());
+	EXPECT_FALSE(compressed_versions({semver("1.0.0"), semver("1.0.0-rc.1")}).ok());
+}
+
+TEST_F(test_compressed, invalid_version)
+{
+	EXPECT_FALSE(compressed_versions({semver("1.0.0"), semver("foo")}).ok());
+}
+
+TEST_F(test_compressed, roundtrip)
+{
+	const auto versions = std::vector<semver> {semver("0.0.0"), semver("0.0.1"),
+		semver("0.0.100"), semver("0.2.0-0"), semver("0.2.0-alpha.01.1+build.7"),
+		semver("0.2.0-alpha.1234567890123456789"), semver("0.2.0-alpha.beta"),
+		semver("0.2.0-x.7.x"), semver("0.2.0+build.7"), semver("0.2.0+other"),
+		semver("5.0.0"), semver("18446744073709551615.18446744073709551615.18446744073709551615")};
+
+	const auto c = compressed_versions(versions);
+	ASSERT_TRUE(c.ok());
+	EXPECT_EQ(versions.size(), c.size());
+	expect_same(versions, decode(c));
+	for (std::size_t i = 0u; i < versions.size(); ++i)
+		EXPECT_EQ(versions[i].str(), c[i].str());
+}
+
+TEST_F(test_compressed, roundtrip_many_blocks)
+{
+	const auto versions = history(1000u);
+	const auto c = compressed_versions(versions);
+	ASSERT_TRUE(c.ok());
+	expect_same(versions, decode(c));
+	for (const auto i : {0u, 1u, 63u, 64u, 65u, 500u, 999u})
+		EXPECT_EQ(versions[i].str(), c[i].str());
+}
+
+TEST_F(test_compressed, memory_usage)
+{
+	const auto versions = history(10000u);
+	const auto c = compressed_versions(versions);
+	ASSERT_TRUE(c.ok());
+
+	EXPECT_LE(c.memory_usage() * 8u, compressed_versions::memory_usage(versions))
+		<< c.memory_usage() << " " << compressed_versions::memory_usage(versions);
+}
+
+TEST_F(test_compressed, max_min_satisfying)
+{
+	const auto versions = history(1000u);
+	const auto c = compressed_versions(versions);
+	ASSERT_TRUE(c.ok());
+
+	for (const auto * s : {"*", "^1.0.0", "~2.3.0", "^3.0.0-alpha.1", ">=3.0.0-beta.1 <3.0.0",
+			 "1.2.3 || 5.0.4", "<0.1.3", ">5.8.0", "^100.0.0", "<0.0.0", "0.1.1 - 0.1.5",
+			 ">=2.1.0 <2.1.5 || >=7.0.0"}) {
+		const auto r = range(s);
+		ASSERT_TRUE(r.ok()) << s;
+		EXPECT_EQ(r.max_satisfying(versions).str(), c.max_satisfying(r).str()) << s;
+		EXPECT_EQ(r.min_satisfying(versions).str(), c.min_satisfying(r).str()) << s;
+	}
+}
+
+TEST_F(test_compressed, max_min_satisfying_random)
+{
+	std::mt19937 gen(42u);
+	auto number = std::uniform_int_distribution<unsigned long>(0u, 4u);
+
+	std::vector<semver> versions;
+	for (std::size_t i = 0u; i < 500u; ++i)
+		versions.push_back(semver(number(gen), number(gen), number(gen),
+			(number(gen) == 0u) ? "rc.1" : "", (number(gen) == 0u) ? "b" : ""));
+	::semver::stable_sort(versions);
+	const auto c = compressed_versions(versions);
+	ASSERT_TRUE(c.ok());
+	expect_same(versions, decode(c));
+
+	for (std::size_t i = 0u; i < 200u; ++i) {
+		const auto lo = semver(number(gen), number(gen), number(gen));
+		const auto hi = semver(number(gen), number(gen), number(gen));
+		const auto r = range(">=" + lo.str() + " <=" + hi.str() + " || " + lo.str());
+		const auto max = r.max_satisfying(versions);
+		const auto min = r.min_satisfying(versions);
+		EXPECT_EQ(max.str(), c.max_satisfying(r).str()) << r;
+		EXPECT_EQ(max.build(), c.max_satisfying(r).build()) << r;
+		EXPECT_EQ(min.str(), c.min_satisfying(r).str()) << r;
+		EXPECT_EQ(min.build(), c.min_satisfying(r).build()) << r;
+	}
+}
+
+TEST_F(test_compressed, max_satisfying_first_of_equal_precedence_across_blocks)
+{
+	std::vector<semver> versions;
+	for (std::size_t i = 0u; i < 60u; ++i)
+		versions.push_back(semver(1, 0, static_cast<semver::number_type>(i)));
+	for (std::size_t i = 0u; i < 100u; ++i)
+		versions.push_back(semver(2, 0, 0, "", "b" + std::to_string(i)));
+	const auto c = compressed_versions(versions);
+	ASSERT_TRUE(c.ok());
+
+	EXPECT_EQ("b0", c.max_satisfying(range("*")).build());
+	EXPECT_EQ("b0", c.min_satisfying(range(">=2.0.0")).build());
+}
+
+TEST_F(test_compressed, invalid_range)
+{
+	const auto c = compressed_versions(history(100u));
+	EXPECT_FALSE(c.max_satisfying(range("foo")).ok());
+	EXPECT_FALSE(c.min_satisfying(range("foo")).ok());
+}
+}
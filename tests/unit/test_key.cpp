@@ -0,0 +1,252 @@
+#include <semver/key.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+
+namespace
+{
+using semver::from_key;
+using semver::to_key;
+using semver::semver;
+
+class test_key : public ::testing::Test
+{
+protected:
+	static int sign(int n) { return (n > 0) - (n < 0); }
+
+	static void expect_same_order(const semver & a, const semver & b)
+	{
+		EXPECT_EQ(::semver::compare(a, b), sign(to_key(a).compare(to_key(b))))
+			<< a << " " << b;
+	}
+};
+
+TEST_F(test_key, semver_org_example)
+{
+	const std::vector<semver> v = {semver("1.0.0-alpha"), semver("1.0.0-alpha.1"),
+		semver("1.0.0-alpha.beta"), semver("1.0.0-beta"), semver("1.0.0-beta.2"),
+		semver("1.0.0-beta.11"), semver("1.0.0-rc.1"), semver("1.0.0"), semver("2.0.0"),
+		semver("2.1.0"), semver("2.1.1")};
+
+	for (std::size_t i = 0; i + 1 < v.size(); ++i)
+		EXPECT_LT(to_key(v[i]), to_key(v[i + 1])) << v[i] << " " << v[i + 1];
+}
+
+TEST_F(test_key, numbers)
+{
+	constexpr auto max = std::numeric_limits<semver::number_type>::max();
+	const std::vector<semver> v = {semver(0, 0, 0), semver(0, 0, 1), semver(0, 0, 255),
+		semver(0, 0, 256), semver(0, 0, 65535), semver(0, 0, max), semver(0, 1, 0),
+		semver(0, max, max), semver(1, 0, 0), semver(255, 0, 0), semver(256, 0, 0),
+		semver(max, max, max)};
+
+	for (std::size_t i = 0; i + 1 < v.size(); ++i)
+		EXPECT_LT(to_key(v[i]), to_key(v[i + 1])) << v[i] << " " << v[i + 1];
+}
+
+TEST_F(test_key, numeric_identifiers)
+{
+	const std::vector<semver> v = {semver("1.0.0-0"), semver("1.0.0-1"), semver("1.0.0-9"),
+		semver("1.0.0-10"), semver("1.0.0-11"), semver("1.0.0-99999999999999999999999"),
+		semver("1.0.0-0a"), semver("1.0.0-a"), semver("1.0.0-a.2.x"), semver("1.0.0-a.11.x"),
+		semver("1.0.0-a.b")};
+
+	for (std::size_t i = 0; i + 1 < v.size(); ++i)
+		EXPECT_LT(to_key(v[i]), to_key(v[i + 1])) << v[i] << " " << v[i + 1];
+}
+
+TEST_F(test_key, alphanumeric_identifiers)
+{
+	expect_same_order(semver("1.0.0-alpha"), semver("1.0.0-alphabet"));
+	expect_same_order(semver("1.0.0-Alpha"), semver("1.0.0-alpha"));
+	expect_same_order(semver("1.0.0--"), semver("1.0.0-a"));
+	expect_same_order(semver("1.0.0-alpha"), semver("1.0.0-alpha.0"));
+	expect_same_order(semver("1.0.0-alpha.beta"), semver("1.0.0-alpha-beta"));
+}
+
+TEST_F(test_key, leading_zeros)
+{
+	expect_same_order(semver("1.2.3-01"), semver("1.2.3-2"));
+	expect_same_order(semver("1.2.3-00"), semver("1.2.3-1"));
+	expect_same_order(semver("1.2.3-00"), semver("1.2.3-01"));
+	expect_same_order(semver("1.2.3-009"), semver("1.2.3-10"));
+	expect_same_order(semver("1.2.3-01"), semver("1.2.3-a"));
+	expect_same_order(semver("1.2.3-rc.01"), semver("1.2.3-rc.2"));
+	EXPECT_NE(to_key(semver("1.2.3-1")), to_key(semver("1.2.3-01")));
+}
+
+TEST_F(test_key, too_many_leading_zeros)
+{
+	std::string key = "x";
+
+	EXPECT_FALSE(::semver::encode_key(semver("1.2.3-" + std::string(65536u, '0') + "1"), key));
+	EXPECT_EQ("x", key);
+	EXPECT_TRUE(::semver::encode_key(semver("1.2.3-" + std::string(65535u, '0') + "1"), key));
+}
+
+TEST_F(test_key, build_ignored)
+{
+	EXPECT_EQ(to_key(semver("1.2.3-rc.1")), to_key(semver("1.2.3-rc.1+build.7")));
+	EXPECT_EQ(semver("1.2.3-rc.1"), from_key(to_key(semver("1.2.3-rc.1+build.7"))));
+}
+
+TEST_F(test_key, invalid_version)
+{
+	std::string key = "x";
+
+	EXPECT_FALSE(::semver::encode_key(semver("foo"), key));
+	EXPECT_EQ("x", key);
+	EXPECT_TRUE(to_key(semver("foo")).empty());
+}
+
+TEST_F(test_key, roundtrip)
+{
+	for (const auto s : {"0.0.0", "1.2.3", "1.2.3-0", "1.2.3-alpha.1", "1.2.3-x.7.z.92",
+			 "1.2.3-0a.00a.-", "1.2.3-01", "1.2.3-00", "1.2.3-rc.007.0",
+			 "18446744073709551615.0.256-rc.1"}) {
+		const auto v = semver(s);
+		ASSERT_TRUE(v.ok()) << s;
+
+		const auto key = to_key(v);
+		const auto d = from_key(key);
+		EXPECT_TRUE(d.ok()) << s;
+		EXPECT_EQ(v.str(), d.str()) << s;
+
+		semver e;
+		EXPECT_EQ(key.size(), ::semver::decode_key(key + "trailing", e)) << s;
+		EXPECT_EQ(v, e) << s;
+	}
+}
+
+TEST_F(test_key, prefix_free)
+{
+	const auto a = to_key(semver("1.2.3-alpha"));
+	const auto b = to_key(semver("1.2.3-alpha.1"));
+	const auto c = to_key(semver("1.2.3"));
+
+	EXPECT_NE(0u, b.compare(0u, a.size(), a));
+	EXPECT_NE(0u, a.compare(0u, c.size(), c));
+}
+
+TEST_F(test_key, invalid_keys)
+{
+	const auto key = to_key(semver("1.256.3-alpha.12"));
+
+	for (std::size_t n = 0; n < key.size(); ++n)
+		EXPECT_FALSE(from_key(key.substr(0, n)).ok()) << n;
+
+	EXPECT_FALSE(from_key(std::string("\x01\x00\x00\x00\x03", 5)).ok()); // leading zero byte
+	EXPECT_FALSE(from_key(std::string("\x09\x00\x00\x03", 4)).ok()); // number too long
+	EXPECT_FALSE(from_key(std::string("\x00\x00\x00\x00", 4)).ok()); // empty prerelease
+	EXPECT_FALSE(from_key(std::string("\x00\x00\x00\x01\x01\x02\x30\x31\x00", 9)).ok());
+	EXPECT_FALSE(from_key(std::string("\x00\x00\x00\x02\x31\x00\x00", 7)).ok());
+	EXPECT_FALSE(from_key(std::string("\x00\x00\x00\x02\x2e\x00\x00", 7)).ok());
+	EXPECT_FALSE(from_key(std::string("\x00\x00\x00\x04", 4)).ok());
+	EXPECT_FALSE(from_key(std::string("\x00\x00\x00\x01\x01\x01\x31\x00", 8)).ok());
+	EXPECT_FALSE(
+		from_key(std::string("\x00\x00\x00\x01\x01\x01\x31\x03\x01\x00\x00\x00", 12)).ok());
+}
+
+TEST_F(test_key, differential)
+{
+	static const char * prereleases[] = {"", "", "0", "1", "2", "10", "11", "alpha", "alpha.1",
+		"alpha.beta", "beta", "beta.2", "beta.11", "rc.1", "x.7.z.92", "0.3.7", "a-b", "A"};
+
+	std::mt19937 gen(4711);
+	std::uniform_int_distribution<semver::number_type> number(0u, 300u);
+	std::uniform_int_distribution<std::size_t> pre(0u, std::size(prereleases) - 1u);
+
+	std::vector<semver> v;
+	for (int i = 0; i < 3000; ++i)
+		v.emplace_back(number(gen) % 3u, number(gen) % 3u, number(gen), prereleases[pre(gen)]);
+
+	auto by_precedence = v;
+	std::stable_sort(begin(by_precedence), end(by_precedence));
+	auto by_key = v;
+	std::stable_sort(begin(by_key), end(by_key),
+		[](const semver & a, const semver & b) { return to_key(a) < to_key(b); });
+
+	EXPECT_EQ(by_precedence, by_key);
+	for (std::size_t i = 0; i + 1 < v.size(); ++i)
+		expect_same_order(v[i], v[i + 1]);
+}
+
+TEST_F(test_key, intervals_simple)
+{
+	const auto i = ::semver::key_intervals(::semver::range(">=1.2.3 <2.0.0"));
+
+	ASSERT_EQ(1u, i.size());
+	EXPECT_EQ(to_key(semver("1.2.3")), i[0].start);
+	EXPECT_EQ(to_key(semver("2.0.0")), i[0].end);
+}
+
+TEST_F(test_key, intervals_exclusive_inclusive)
+{
+	const auto i = ::semver::key_intervals(::semver::range(">1.2.3 <=2.0.0"));
+
+	ASSERT_EQ(1u, i.size());
+	EXPECT_LT(to_key(semver("1.2.3")), i[0].start);
+	EXPECT_GT(to_key(semver("1.2.4-0")), i[0].start);
+	EXPECT_LT(to_key(semver("2.0.0")), i[0].end);
+	EXPECT_GT(to_key(semver("2.0.1-0")), i[0].end);
+}
+
+TEST_F(test_key, intervals_unbounded)
+{
+	const auto any = ::semver::key_intervals(::semver::range("*"));
+	ASSERT_EQ(1u, any.size());
+	EXPECT_EQ(to_key(semver("0.0.0")), any[0].start);
+	EXPECT_TRUE(any[0].end.empty());
+
+	const auto below = ::semver::key_intervals(::semver::range("<1.0.0"));
+	ASSERT_EQ(1u, below.size());
+	EXPECT_TRUE(below[0].start.empty());
+	EXPECT_EQ(to_key(semver("1.0.0")), below[0].end);
+}
+
+TEST_F(test_key, intervals_none)
+{
+	EXPECT_TRUE(::semver::key_intervals(::semver::range(">2.0.0 <1.0.0")).empty());
+	EXPECT_TRUE(::semver::key_intervals(::semver::range("foo")).empty());
+}
+
+TEST_F(test_key, intervals_merged_and_sorted)
+{
+	const auto i = ::semver::key_intervals(::semver::range("~3.4.0 || ^1.2.0 || 1.5.x"));
+
+	ASSERT_EQ(2u, i.size());
+	EXPECT_LT(i[0].end, i[1].start);
+}
+
+TEST_F(test_key, intervals_differential)
+{
+	static const char * prereleases[] = {"", "", "", "0", "1", "alpha", "alpha.1", "rc.1"};
+
+	std::mt19937 gen(815);
+	std::uniform_int_distribution<semver::number_type> number(0u, 5u);
+	std::uniform_int_distribution<std::size_t> pre(0u, std::size(prereleases) - 1u);
+
+	std::vector<semver> v;
+	for (int i = 0; i < 2000; ++i)
+		v.emplace_back(number(gen), number(gen), number(gen), prereleases[pre(gen)]);
+
+	for (const auto s : {"^1.2.0 || ~3.4.0", ">=1.2.3-alpha <1.2.3", ">1.2.3 <=2.0.0-rc.1",
+			 "1.x || >=4.0.0", "<0.0.1", ">5.5.5", "=2.3.4-alpha.1", "*", "1.2.3 || 1.2.4",
+			 ">=1.0.0 <2.0.0 || >=1.5.0 <3.0.0-0", "<2.0.0 || >2.0.0"}) {
+		const auto r = ::semver::range(s);
+		const auto intervals = ::semver::key_intervals(r);
+
+		for (std::size_t i = 0; i + 1 < intervals.size(); ++i)
+			EXPECT_LE(intervals[i].end, intervals[i + 1].start) << s;
+
+		for (const auto & x : v) {
+			const auto key = to_key(x);
+			const bool in = std::any_of(begin(intervals), end(intervals), [&key](const auto & i) {
+				return (i.start <= key) && (i.end.empty() || (key < i.end));
+			});
+			EXPECT_EQ(r.satisfies(x), in) << s << " " << x;
+		}
+	}
+}
+}
@@ -0,0 +1,168 @@
+#include <semver/lazy_range.hpp>
+#include "detail/range_parser.hpp"
+#include <gtest/gtest.h>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace
+{
+using semver::lazy_range;
+using semver::range;
+using semver::range_check;
+using semver::semver;
+
+class test_lazy_range : public ::testing::Test {};
+
+TEST_F(test_lazy_range, compiled_on_first_use)
+{
+	const auto r = lazy_range("^1.2.3");
+
+	EXPECT_FALSE(r.compiled());
+	EXPECT_EQ("^1.2.3", r.text());
+	EXPECT_TRUE(r.satisfies(semver("1.5.0")));
+	EXPECT_TRUE(r.compiled());
+	EXPECT_FALSE(r.satisfies(semver("2.0.0")));
+}
+
+TEST_F(test_lazy_range, same_as_range)
+{
+	for (const auto s : {"1.2.3", "^1.2.3 || ~2.0.0-rc.1", ">=1.0.0 <2.0.0 || 3.x", "1 - 2", "*"}) {
+		const auto r = range(s);
+		const auto l = lazy_range(s);
+
+		EXPECT_TRUE(l.ok()) << s;
+		EXPECT_EQ(to_string(r), to_string(l)) << s;
+		EXPECT_EQ(r.min(), l.min()) << s;
+		EXPECT_EQ(r.max(), l.max()) << s;
+		EXPECT_EQ(r, l.get()) << s;
+
+		std::ostringstream os;
+		os << l;
+		EXPECT_EQ(to_string(r), os.str()) << s;
+	}
+}
+
+TEST_F(test_lazy_range, queries)
+{
+	const auto r = lazy_range(">=1.2.0 <2.0.0");
+	const auto v = std::vector<semver> {semver("1.1.0"), semver("1.2.0"), semver("1.9.0"),
+		semver("2.0.0")};
+
+	EXPECT_EQ(semver("1.9.0"), r.max_satisfying(v));
+	EXPECT_EQ(semver("1.2.0"), r.min_satisfying(v));
+	EXPECT_TRUE(r.gtr(semver("2.0.0")));
+	EXPECT_TRUE(r.ltr(semver("1.1.0")));
+	EXPECT_TRUE(r.outside(semver("2.0.0")));
+}
+
+TEST_F(test_lazy_range, invalid)
+{
+	const auto unchecked = lazy_range("foo");
+	EXPECT_FALSE(unchecked.ok());
+	EXPECT_TRUE(unchecked.compiled());
+	EXPECT_FALSE(unchecked.satisfies(semver("1.0.0")));
+
+	const auto checked = lazy_range("foo", range_check::syntax);
+	EXPECT_FALSE(checked.ok());
+	EXPECT_FALSE(checked.compiled());
+	EXPECT_FALSE(checked.satisfies(semver("1.0.0")));
+}
+
+TEST_F(test_lazy_range, syntax_check_valid_not_compiled)
+{
+	const auto r = lazy_range("^1.2.3 || 2.x", range_check::syntax);
+
+	EXPECT_FALSE(r.compiled());
+	EXPECT_TRUE(r.ok());
+	EXPECT_TRUE(r.compiled());
+}
+
+TEST_F(test_lazy_range, limits)
+{
+	const auto limits = ::semver::range_limits {1024u, 1u, 1024u};
+
+	EXPECT_FALSE(lazy_range("1.x || 2.x", range_check::syntax, limits).ok());
+	EXPECT_FALSE(lazy_range("1.x || 2.x", range_check::none, limits).ok());
+	EXPECT_TRUE(lazy_range("1.x", range_check::syntax, limits).ok());
+}
+
+TEST_F(test_lazy_range, copy_and_move)
+{
+	const auto r = lazy_range("^1.2.3");
+	const auto a = r; // not compiled
+	EXPECT_FALSE(a.compiled());
+
+	EXPECT_TRUE(r.ok());
+	const auto b = r;
+	EXPECT_FALSE(b.compiled());
+	EXPECT_TRUE(b.satisfies(semver("1.3.0")));
+
+	auto c = lazy_range("~2.0.0");
+	EXPECT_TRUE(c.ok());
+	const auto d = std::move(c);
+	EXPECT_TRUE(d.compiled());
+	EXPECT_TRUE(d.satisfies(semver("2.0.5")));
+
+	std::vector<lazy_range> v;
+	for (int i = 0; i < 100; ++i)
+		v.emplace_back("^1.2.3");
+	EXPECT_TRUE(v.front().satisfies(semver("1.2.4")));
+	EXPECT_FALSE(v.back().compiled());
+}
+
+TEST_F(test_lazy_range, compiled_once_by_threads)
+{
+	const auto r = lazy_range(">=1.0.0 <2.0.0 || 3.x");
+
+	std::vector<std::thread> threads;
+	std::vector<const range *> compiled(4u, nullptr);
+	for (std::size_t i = 0; i < compiled.size(); ++i)
+		threads.emplace_back([&r, &compiled, i] {
+			EXPECT_TRUE(r.satisfies(semver("3.1.0")));
+			compiled[i] = &r.get();
+		});
+	for (auto & t : threads)
+		t.join();
+
+	for (const auto * p : compiled)
+		EXPECT_EQ(compiled.front(), p);
+}
+
+TEST_F(test_lazy_range, syntax_check_same_as_parser)
+{
+	const auto limits = ::semver::range_limits {64u, 2u, 3u};
+
+	for (const auto s : {"", " ", "*", "1.2.3", "1.2.3 ||", "|| 1.2.3", "||", "1 - 2", "1 - 2 3",
+			 "1 -", "- 1", "1 - ^2", "^1.2.3 || ~2.0.0-rc.1", ">=1 <2 >3", ">=1 <2 >3 <4",
+			 "1 || 2", "1 || 2 || 3", "foo", "1.2.3 foo", "1.2.3-", "1.2.3+", ">=", "~", "^",
+			 "99999999999999999999999", "1.2.3 - 2.3.4 || 5", "1 | 2", "=1.2.3", "x.X.*",
+			 "1.2.3 -2", "1.2.3- 2", "<1.2.3-alpha.1+b.2 >=1.0.0",
+			 "1234567890123456789012345678901234567890123456789012345678901234567890"}) {
+		EXPECT_EQ(range(s, limits).ok(), ::semver::detail::check_range_syntax(s, limits)) << s;
+		EXPECT_EQ(range(s).ok(), ::semver::detail::check_range_syntax(s)) << s;
+	}
+}
+
+TEST_F(test_lazy_range, syntax_check_same_as_parser_generated)
+{
+	// all texts of up to four characters of the alphabet of ranges
+	const auto alphabet = std::string_view("0 1.-^~<>=|xa+");
+	const auto limits = ::semver::range_limits {64u, 2u, 2u};
+
+	std::string s;
+	const std::function<void()> generate = [&] {
+		EXPECT_EQ(range(s, limits).ok(), ::semver::detail::check_range_syntax(s, limits)) << s;
+		if (s.size() == 4u)
+			return;
+		for (const auto c : alphabet) {
+			s.push_back(c);
+			generate();
+			s.pop_back();
+		}
+	};
+	generate();
+}
+}
@@ -0,0 +1,272 @@
+#include <semver/pmr.hpp>
+#include <semver/allocation.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <memory_resource>
+#include <utility>
+#include <sstream>
+#include <string>
+
+namespace
+{
+namespace pmr = ::semver::pmr;
+
+// forwards to the default resource, counts the allocations
+class counting_resource final : public std::pmr::memory_resource
+{
+public:
+	std::size_t allocations = 0u;
+	std::size_t deallocations = 0u;
+
+private:
+	void * do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		++allocations;
+		return std::pmr::get_default_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override
+	{
+		++deallocations;
+		std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+class test_pmr : public ::testing::Test
+{
+protected:
+	static constexpr const char * long_version
+		= "1.2.3-some.rather.long.prerelease.identifier+and.a.long.build.12345";
+};
+
+TEST_F(test_pmr, semver_parse)
+{
+	counting_resource mr;
+	{
+		const auto v = pmr::semver(long_version, &mr);
+
+		ASSERT_TRUE(v.ok());
+		EXPECT_EQ(1u, v.major());
+		EXPECT_EQ(2u, v.minor());
+		EXPECT_EQ(3u, v.patch());
+		EXPECT_EQ("some.rather.long.prerelease.identifier", v.prerelease());
+		EXPECT_EQ("and.a.long.build.12345", v.build());
+		EXPECT_EQ(long_version, v.str());
+		EXPECT_EQ(&mr, v.get_allocator().resource());
+		EXPECT_EQ(::semver::semver(long_version), v.to_semver());
+	}
+	EXPECT_GE(mr.allocations, 2u);
+	EXPECT_EQ(mr.allocations, mr.deallocations);
+}
+
+TEST_F(test_pmr, semver_loose_uses_resource)
+{
+	counting_resource mr;
+	const auto v = pmr::semver(" v 1.2.3-some.rather.long.prerelease.identifier ", true, &mr);
+
+	ASSERT_TRUE(v.ok());
+	EXPECT_EQ("1.2.3-some.rather.long.prerelease.identifier", v.str());
+	EXPECT_GE(mr.allocations, 2u);
+}
+
+TEST_F(test_pmr, semver_invalid)
+{
+	EXPECT_FALSE(pmr::semver("1.2").ok());
+	EXPECT_FALSE(pmr::semver(1, 2, 3, "a..b").ok());
+	EXPECT_FALSE(pmr::semver().ok());
+	EXPECT_FALSE(pmr::semver("foo").to_semver().ok());
+	EXPECT_EQ("<invalid>", pmr::semver("foo").str());
+}
+
+TEST_F(test_pmr, semver_construction)
+{
+	EXPECT_EQ("1.2.3", pmr::semver(1, 2, 3).str());
+	EXPECT_EQ("1.2.3-rc.1+b", pmr::semver(1, 2, 3, "rc.1", "b").str());
+	EXPECT_EQ("1.2.3-rc.1", pmr::semver(::semver::semver("1.2.3-rc.1")).str());
+}
+
+TEST_F(test_pmr, semver_copy_with_resource)
+{
+	counting_resource a;
+	counting_resource b;
+	const auto v = pmr::semver(long_version, &a);
+	const auto allocations = a.allocations;
+
+	const auto c = pmr::semver(v, &b);
+	EXPECT_EQ(v, c);
+	EXPECT_EQ(&b, c.get_allocator().resource());
+	EXPECT_EQ(allocations, a.allocations);
+	EXPECT_GE(b.allocations, 2u);
+}
+
+TEST_F(test_pmr, semver_comparison)
+{
+	EXPECT_LT(pmr::semver("1.0.0-alpha"), pmr::semver("1.0.0-alpha.1"));
+	EXPECT_LT(pmr::semver("1.0.0-beta.2"), pmr::semver("1.0.0-beta.11"));
+	EXPECT_LT(pmr::semver("1.0.0-rc.1"), pmr::semver("1.0.0"));
+	EXPECT_EQ(pmr::semver("1.0.0+a"), pmr::semver("1.0.0+b"));
+	EXPECT_EQ(0, compare(pmr::semver("1.0.0"), pmr::semver("1.0.0")));
+	EXPECT_EQ(1, compare(pmr::semver("1.0.1"), pmr::semver("1.0.0")));
+}
+
+TEST_F(test_pmr, semver_comparison_same_as_semver)
+{
+	static const std::array<std::pair<const char *, const char *>, 8> pairs = {{
+		{"1.0.0", "1.0.0"},
+		{"1.0.0", "1.0.1"},
+		{"1.0.0-rc.1", "1.0.0"},
+		{"1.0.0-alpha", "1.0.0-alpha.1"},
+		{"1.0.0+a", "1.0.0+b"},
+		{"1.0.0-01", "1.0.0-1"},
+		{"1.0.0-1", "1.0.0-01"},
+		{"1.0.0-alpha.001", "1.0.0-alpha.1"},
+	}};
+
+	for (const auto & [a, b] : pairs) {
+		const auto s1 = ::semver::semver(a, true);
+		const auto s2 = ::semver::semver(b, true);
+		const auto p1 = pmr::semver(a, true, {});
+		const auto p2 = pmr::semver(b, true, {});
+
+		ASSERT_TRUE(s1.ok() && s2.ok() && p1.ok() && p2.ok()) << a << " " << b;
+
+		EXPECT_EQ(s1 == s2, p1 == p2) << a << " " << b;
+		EXPECT_EQ(s1 != s2, p1 != p2) << a << " " << b;
+		EXPECT_EQ(s1 < s2, p1 < p2) << a << " " << b;
+		EXPECT_EQ(s1 <= s2, p1 <= p2) << a << " " << b;
+		EXPECT_EQ(s1 > s2, p1 > p2) << a << " " << b;
+		EXPECT_EQ(s1 >= s2, p1 >= p2) << a << " " << b;
+		EXPECT_EQ(compare(s1, s2), compare(p1, p2)) << a << " " << b;
+	}
+}
+
+TEST_F(test_pmr, semver_format)
+{
+	const auto v = pmr::semver("1.2.3-rc.1+b.7");
+	std::array<char, 32> buf = {};
+
+	EXPECT_EQ(buf.data() + formatted_size(v), format_to(buf.data(), v));
+	EXPECT_STREQ("1.2.3-rc.1+b.7", buf.data());
+
+	std::ostringstream os;
+	os << v;
+	EXPECT_EQ("1.2.3-rc.1+b.7", os.str());
+}
+
+TEST_F(test_pmr, range_same_as_range)
+{
+	for (const auto s : {"1.2.3", "^1.2.3 || ~2.0.0-rc.1", ">=1.0.0 <2.0.0 || 3.x || *",
+			 "1.2.3 - 2.3.4", "<1.0.0-alpha.beta.gamma.delta.epsilon", "",
+			 "2.x || 1.x || 0.0.3", "^1.2.3 ~1.2.5 >=1.2.4 || 1.0.0", "3.0.0 - 1.0.0",
+			 "1.x - 2 || 1.2.3 - 1.2.3", ">=1.0.0 <=1.0.0 || <0.5.0 >0.1.0 || ^0.0.0",
+			 "~2.0.0-rc.1 || ^1.2.3 || <1.0.0-alpha.beta.gamma.delta.epsilon || *"}) {
+		const auto r = ::semver::range(s);
+		const auto p = pmr::range(s);
+
+		ASSERT_TRUE(p.ok()) << s;
+		EXPECT_EQ(to_string(r), to_string(p)) << s;
+		EXPECT_EQ(r, p.to_range()) << s;
+		EXPECT_EQ(p, pmr::range(r)) << s;
+
+		for (const auto v : {"0.0.0", "1.2.3", "1.2.4-rc.1", "1.9.9", "2.0.0-rc.1", "2.0.0-rc.2",
+				 "2.0.5", "3.4.5", "0.9.9-alpha.beta.gamma.delta.epsilon", "1.0.0-alpha"}) {
+			EXPECT_EQ(r.satisfies(::semver::semver(v)), p.satisfies(pmr::semver(v))) << s << " " << v;
+			EXPECT_EQ(r.satisfies(::semver::semver(v)), p.satisfies(::semver::semver(v)))
+				<< s << " " << v;
+		}
+	}
+}
+
+TEST_F(test_pmr, range_invalid)
+{
+	EXPECT_FALSE(pmr::range("foo").ok());
+	EXPECT_FALSE(pmr::range().ok());
+	EXPECT_FALSE(pmr::range("foo").satisfies(pmr::semver("1.2.3")));
+	EXPECT_FALSE(pmr::range("*").satisfies(pmr::semver("foo")));
+	EXPECT_FALSE(pmr::range("1.x || 2.x", {1024u, 1u, 1024u}).ok());
+	EXPECT_FALSE(pmr::range("foo").to_range().ok());
+}
+
+TEST_F(test_pmr, construction_from_string)
+{
+	counting_resource mr;
+	const std::string vs = "1.2.3-rc.1";
+	const std::string rs = "^1.2.0 || ~2.0.0-rc.1";
+
+	const pmr::semver v1(vs);
+	const pmr::semver v2(vs, &mr);
+	const pmr::range r1(rs);
+	const pmr::range r2(rs, &mr);
+
+	ASSERT_TRUE(v1.ok());
+	ASSERT_TRUE(r1.ok());
+	EXPECT_EQ("1.2.3-rc.1", v1.str());
+	EXPECT_EQ(v1, v2);
+	EXPECT_EQ(&mr, v2.get_allocator().resource());
+	EXPECT_EQ(r1, r2);
+	EXPECT_EQ(&mr, r2.get_allocator().resource());
+	EXPECT_EQ(::semver::range(rs), r1.to_range());
+}
+
+TEST_F(test_pmr, range_uses_resource)
+{
+	counting_resource mr;
+	{
+		const auto r = pmr::range(">=1.2.3-some.rather.long.prerelease <2.0.0 || 3.x", &mr);
+
+		ASSERT_TRUE(r.ok());
+		EXPECT_EQ(&mr, r.get_allocator().resource());
+
+		// comparators, alternatives, prereleases, and the temporary memory of the parser
+		EXPECT_EQ(3u, mr.allocations - mr.deallocations);
+		EXPECT_LE(mr.allocations, 5u);
+
+		const auto allocations = mr.allocations;
+		const auto c = pmr::range(r, &mr);
+		EXPECT_EQ(r, c);
+		EXPECT_EQ(allocations + 3u, mr.allocations);
+	}
+	EXPECT_EQ(mr.allocations, mr.deallocations);
+}
+
+TEST_F(test_pmr, arena)
+{
+	std::array<std::byte, 4096> buffer;
+	std::pmr::monotonic_buffer_resource arena(
+		buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+	const auto stats = ::semver::count_allocations([&arena] {
+		const auto r = pmr::range("^1.2.0-alpha.long.prerelease.identifier || ~2.0.0", &arena);
+		const auto v = pmr::semver(long_version, &arena);
+		EXPECT_TRUE(r.satisfies(v));
+	});
+
+	if (::semver::allocation_counting_enabled()) {
+		EXPECT_EQ(0u, stats.count);
+	}
+}
+
+TEST_F(test_pmr, arena_parse_reordered)
+{
+	if (!::semver::allocation_counting_enabled())
+		GTEST_SKIP() << "library built without ENABLE_ALLOCATION_COUNTING";
+
+	std::array<std::byte, 4096> buffer;
+	std::pmr::monotonic_buffer_resource arena(
+		buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+	// alternatives and comparators are reordered, using temporary memory of the arena
+	const auto stats = ::semver::count_allocations([&arena] {
+		const auto r = pmr::range(
+			"^2.0.0-some.long.prerelease.text ~1.2.3 || 0.0.1 || >=1.0.0 <1.5.0", &arena);
+		EXPECT_TRUE(r.ok());
+	});
+
+	EXPECT_EQ(0u, stats.count);
+}
+}
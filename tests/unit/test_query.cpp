@@ -0,0 +1,197 @@
+#include <semver/query.hpp>
+#include <semver/binary.hpp>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+using semver::latest_per_line;
+using semver::range;
+using semver::release_line;
+using semver::semver_view;
+using semver::top_satisfying;
+using semver::semver;
+
+class test_query : public ::testing::Test
+{
+protected:
+	static std::vector<semver> versions()
+	{
+		return {semver("1.0.0"), semver("2.1.0"), semver("1.4.2"), semver("3.0.0-rc.1"),
+			semver("1.4.10"), semver("2.0.5"), semver("1.2.0"), semver("2.1.0-beta"),
+			semver("0.9.0"), semver("2.1.3")};
+	}
+
+	// Versions read from a stream, an input iterator.
+	class stream_iterator final
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = semver;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const semver *;
+		using reference = const semver &;
+
+		stream_iterator() = default;
+
+		explicit stream_iterator(std::istream & is)
+			: is_(&is)
+		{
+			++*this;
+		}
+
+		reference operator*() const { return current_; }
+
+		stream_iterator & operator++()
+		{
+			std::string s;
+			if (*is_ >> s) {
+				current_ = semver(s);
+			} else {
+				is_ = nullptr;
+			}
+			return *this;
+		}
+
+		friend bool operator==(const stream_iterator & a, const stream_iterator & b)
+		{
+			return a.is_ == b.is_;
+		}
+		friend bool operator!=(const stream_iterator & a, const stream_iterator & b)
+		{
+			return !(a == b);
+		}
+
+	private:
+		std::istream * is_ = nullptr;
+		semver current_;
+	};
+};
+
+TEST_F(test_query, top_satisfying)
+{
+	const auto r = range(">=1.2.0 <2.2.0");
+
+	EXPECT_EQ((std::vector<semver> {semver("2.1.3"), semver("2.1.0"), semver("2.1.0-beta")}),
+		top_satisfying(r, versions(), 3u));
+	EXPECT_EQ((std::vector<semver> {semver("2.1.3")}), top_satisfying(r, versions(), 1u));
+}
+
+TEST_F(test_query, top_satisfying_fewer_than_k)
+{
+	const auto r = range("^1.0.0");
+
+	EXPECT_EQ((std::vector<semver> {semver("1.4.10"), semver("1.4.2"), semver("1.2.0"),
+				  semver("1.0.0")}),
+		top_satisfying(r, versions(), 10u));
+}
+
+TEST_F(test_query, top_satisfying_none)
+{
+	EXPECT_TRUE(top_satisfying(range("^5.0.0"), versions(), 3u).empty());
+	EXPECT_TRUE(top_satisfying(range("*"), versions(), 0u).empty());
+	EXPECT_TRUE(top_satisfying(range("*"), std::vector<semver> {}, 3u).empty());
+}
+
+TEST_F(test_query, top_satisfying_same_as_sorting)
+{
+	const auto all = versions();
+	for (const auto * s : {"*", "^1.0.0", ">=1.2.0 <3.0.0", "~2.1.0 || <1.0.0", ">=2.1.0-0"}) {
+		const auto r = range(s);
+		std::vector<semver> expected;
+		for (const auto & v : all)
+			if (r.satisfies(v))
+				expected.push_back(v);
+		std::stable_sort(begin(expected), end(expected),
+			[](const semver & a, const semver & b) { return b < a; });
+
+		for (std::size_t k = 0u; k <= all.size() + 1u; ++k) {
+			auto e = expected;
+			e.resize(std::min(k, e.size()));
+			EXPECT_EQ(e, top_satisfying(r, all, k)) << s << " " << k;
+		}
+	}
+}
+
+TEST_F(test_query, top_satisfying_first_of_equal_precedence)
+{
+	const auto all = std::vector<semver> {semver("1.0.0+a"), semver("1.1.0"), semver("1.0.0+b"),
+		semver("1.0.0+c")};
+
+	const auto result = top_satisfying(range("*"), all, 3u);
+	ASSERT_EQ(3u, result.size());
+	EXPECT_EQ("", result[0].build());
+	EXPECT_EQ("a", result[1].build());
+	EXPECT_EQ("b", result[2].build());
+}
+
+TEST_F(test_query, top_satisfying_input_iterator)
+{
+	auto is = std::istringstream("1.0.0 2.1.0 1.4.2 foo 1.4.10");
+
+	EXPECT_EQ((std::vector<semver> {semver("1.4.10"), semver("1.4.2")}),
+		top_satisfying(range("^1.0.0"), stream_iterator(is), stream_iterator(), 2u));
+}
+
+TEST_F(test_query, top_satisfying_views)
+{
+	std::string buf;
+	for (const auto & v : versions())
+		ASSERT_TRUE(encode(v, buf));
+	std::vector<semver_view> views;
+	for (std::string_view data = buf; !data.empty();) {
+		views.push_back(semver_view(data));
+		data.remove_prefix(views.back().size());
+	}
+
+	const auto result = top_satisfying(range("~2.1.0"), views, 5u);
+	ASSERT_EQ(2u, result.size());
+	EXPECT_EQ(semver("2.1.3"), result[0].to_semver());
+	EXPECT_EQ(semver("2.1.0"), result[1].to_semver());
+}
+
+TEST_F(test_query, latest_per_major)
+{
+	EXPECT_EQ((std::vector<semver> {semver("0.9.0"), semver("1.4.10"), semver("2.1.3"),
+				  semver("3.0.0-rc.1")}),
+		latest_per_line(range("*"), versions(), release_line::major));
+	EXPECT_EQ((std::vector<semver> {semver("1.4.10"), semver("2.1.3"), semver("3.0.0-rc.1")}),
+		latest_per_line(range(">=1.0.0-0"), versions(), release_line::major));
+}
+
+TEST_F(test_query, latest_per_minor)
+{
+	EXPECT_EQ((std::vector<semver> {semver("1.0.0"), semver("1.2.0"), semver("1.4.10"),
+				  semver("2.0.5"), semver("2.1.3")}),
+		latest_per_line(range(">=1.0.0 <2.2.0"), versions(), release_line::minor));
+}
+
+TEST_F(test_query, latest_per_line_none)
+{
+	EXPECT_TRUE(latest_per_line(range("^5.0.0"), versions(), release_line::major).empty());
+	EXPECT_TRUE(latest_per_line(range("*"), std::vector<semver> {}, release_line::minor).empty());
+}
+
+TEST_F(test_query, latest_per_line_first_of_equal_precedence)
+{
+	const auto all
+		= std::vector<semver> {semver("1.0.0+a"), semver("2.0.0+a"), semver("1.0.0+b")};
+
+	const auto result = latest_per_line(range("*"), all, release_line::major);
+	ASSERT_EQ(2u, result.size());
+	EXPECT_EQ("a", result[0].build());
+	EXPECT_EQ("a", result[1].build());
+}
+
+TEST_F(test_query, latest_per_line_input_iterator)
+{
+	auto is = std::istringstream("1.0.0 2.1.0 1.4.2 foo 1.4.10 2.0.0");
+
+	EXPECT_EQ((std::vector<semver> {semver("1.4.10"), semver("2.1.0")}),
+		latest_per_line(
+			range("^1.0.0 || ^2.0.0"), stream_iterator(is), stream_iterator(), release_line::major));
+}
+}
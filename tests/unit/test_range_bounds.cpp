@@ -27,14 +27,14 @@ TEST_F(test_range_bounds, xrange_wildcard_position)
 {
 	// clang-format off
 	static const std::array<lexer::parts, 8> tab = {
-		lexer::parts{"1.2.3", "1.2.3", true,  "", "1", "2", "3", "", ""},
-		lexer::parts{"1.2.*", "1.2.*", false, "", "1", "2", "*", "", ""},
-		lexer::parts{"1.*.3", "1.*.3", false, "", "1", "*", "3", "", ""},
-		lexer::parts{"1.*.*", "1.*.*", false, "", "1", "*", "*", "", ""},
-		lexer::parts{"*.2.3", "*.2.3", false, "", "*", "2", "3", "", ""},
-		lexer::parts{"*.2.*", "*.2.*", false, "", "*", "2", "*", "", ""},
-		lexer::parts{"*.*.3", "*.*.3", false, "", "*", "*", "3", "", ""},
-		lexer::parts{"*.*.*", "*.*.*", false, "", "*", "*", "*", "", ""},
+		lexer::parts{"1.2.3", "1.2.3", true, "", "1", "2", "3", "", "", false, false, false, 1, 2, 3},
+		lexer::parts{"1.2.*", "1.2.*", false, "", "1", "2", "*", "", "", false, false, true, 1, 2, 0},
+		lexer::parts{"1.*.3", "1.*.3", false, "", "1", "*", "3", "", "", false, true, false, 1, 0, 3},
+		lexer::parts{"1.*.*", "1.*.*", false, "", "1", "*", "*", "", "", false, true, true, 1, 0, 0},
+		lexer::parts{"*.2.3", "*.2.3", false, "", "*", "2", "3", "", "", true, false, false, 0, 2, 3},
+		lexer::parts{"*.2.*", "*.2.*", false, "", "*", "2", "*", "", "", true, false, true, 0, 2, 0},
+		lexer::parts{"*.*.3", "*.*.3", false, "", "*", "*", "3", "", "", true, true, false, 0, 0, 3},
+		lexer::parts{"*.*.*", "*.*.*", false, "", "*", "*", "*", "", "", true, true, true, 0, 0, 0},
 	};
 	// clang-format on
 
@@ -46,7 +46,8 @@ TEST_F(test_range_bounds, xrange_wildcard_position)
 
 TEST_F(test_range_bounds, major_minor_patch)
 {
-	const lexer::parts p {"1.2.3", "1.2.3", true, "", "1", "2", "3", "", ""};
+	const lexer::parts p {"1.2.3", "1.2.3", true, "", "1", "2", "3", "", "",
+		false, false, false, 1, 2, 3};
 
 	EXPECT_EQ(semver("1.2.3"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.2.3"), upper_bound(p)) << "token=" << p.token;
@@ -54,7 +55,8 @@ TEST_F(test_range_bounds, major_minor_patch)
 
 TEST_F(test_range_bounds, major_minor)
 {
-	const lexer::parts p {"1.2", "1.2", false, "", "1", "2", "", "", ""};
+	const lexer::parts p {"1.2", "1.2", false, "", "1", "2", "", "", "",
+		false, false, false, 1, 2, 0};
 
 	EXPECT_EQ(semver("1.2.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.3.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -62,7 +64,8 @@ TEST_F(test_range_bounds, major_minor)
 
 TEST_F(test_range_bounds, major)
 {
-	const lexer::parts p {"1", "1", false, "", "1", "", "", "", ""};
+	const lexer::parts p {"1", "1", false, "", "1", "", "", "", "",
+		false, false, false, 1, 0, 0};
 
 	EXPECT_EQ(semver("1.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -70,7 +73,8 @@ TEST_F(test_range_bounds, major)
 
 TEST_F(test_range_bounds, major_minor_patch_build)
 {
-	const lexer::parts p {"1.2.3+1", "1.2.3+1", true, "", "1", "2", "3", "", "1"};
+	const lexer::parts p {"1.2.3+1", "1.2.3+1", true, "", "1", "2", "3", "", "1",
+		false, false, false, 1, 2, 3};
 
 	EXPECT_EQ(semver("1.2.3"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.2.3"), upper_bound(p)) << "token=" << p.token;
@@ -78,7 +82,8 @@ TEST_F(test_range_bounds, major_minor_patch_build)
 
 TEST_F(test_range_bounds, major_minor_build)
 {
-	const lexer::parts p {"1.2+1", "1.2+1", false, "", "1", "2", "", "", "1"};
+	const lexer::parts p {"1.2+1", "1.2+1", false, "", "1", "2", "", "", "1",
+		false, false, false, 1, 2, 0};
 
 	EXPECT_EQ(semver("1.2.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.3.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -86,7 +91,8 @@ TEST_F(test_range_bounds, major_minor_build)
 
 TEST_F(test_range_bounds, major_build)
 {
-	const lexer::parts p {"1+1", "1+1", false, "", "1", "", "", "", "1"};
+	const lexer::parts p {"1+1", "1+1", false, "", "1", "", "", "", "1",
+		false, false, false, 1, 0, 0};
 
 	EXPECT_EQ(semver("1.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -94,15 +100,29 @@ TEST_F(test_range_bounds, major_build)
 
 TEST_F(test_range_bounds, major_minor_patch_prerelease)
 {
-	const lexer::parts p {"1.2.3-1", "1.2.3-1", true, "", "1", "2", "3", "1", ""};
+	const lexer::parts p {"1.2.3-1", "1.2.3-1", true, "", "1", "2", "3", "1", "",
+		false, false, false, 1, 2, 3};
 
 	EXPECT_EQ(semver("1.2.3-1"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.2.3-1"), upper_bound(p)) << "token=" << p.token;
 }
 
+TEST_F(test_range_bounds, major_minor_patch_prerelease_build)
+{
+	const lexer::parts p {"1.2.3-alpha.1+build.5", "1.2.3-alpha.1+build.5", true, "", "1",
+		"2", "3", "alpha.1", "build.5", false, false, false, 1, 2, 3};
+
+	const auto l = lower_bound(p);
+	EXPECT_EQ(semver("1.2.3-alpha.1"), l) << "token=" << p.token;
+	EXPECT_EQ("alpha.1", l.prerelease());
+	EXPECT_EQ("", l.build());
+	EXPECT_EQ(semver("1.2.3-alpha.1"), upper_bound(p)) << "token=" << p.token;
+}
+
 TEST_F(test_range_bounds, major_minor_prerelease)
 {
-	const lexer::parts p {"1.2-1", "1.2-1", false, "", "1", "2", "", "1", ""};
+	const lexer::parts p {"1.2-1", "1.2-1", false, "", "1", "2", "", "1", "",
+		false, false, false, 1, 2, 0};
 
 	EXPECT_EQ(semver("1.2.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.3.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -110,7 +130,8 @@ TEST_F(test_range_bounds, major_minor_prerelease)
 
 TEST_F(test_range_bounds, major_prerelease)
 {
-	const lexer::parts p {"1-1", "1-1", false, "", "1", "", "", "1", ""};
+	const lexer::parts p {"1-1", "1-1", false, "", "1", "", "", "1", "",
+		false, false, false, 1, 0, 0};
 
 	EXPECT_EQ(semver("1.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -118,7 +139,8 @@ TEST_F(test_range_bounds, major_prerelease)
 
 TEST_F(test_range_bounds, xrange_major_only)
 {
-	const lexer::parts p {"1", "1", false, "", "1", "", "", "", ""};
+	const lexer::parts p {"1", "1", false, "", "1", "", "", "", "",
+		false, false, false, 1, 0, 0};
 
 	EXPECT_EQ(semver("1.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -126,7 +148,8 @@ TEST_F(test_range_bounds, xrange_major_only)
 
 TEST_F(test_range_bounds, xrange_major_minor_only)
 {
-	const lexer::parts p {"1.2", "1.2", false, "", "1", "2", "", "", ""};
+	const lexer::parts p {"1.2", "1.2", false, "", "1", "2", "", "", "",
+		false, false, false, 1, 2, 0};
 
 	EXPECT_EQ(semver("1.2.0"), lower_bound(p));
 	EXPECT_EQ(semver("1.3.0-0"), upper_bound(p));
@@ -134,7 +157,8 @@ TEST_F(test_range_bounds, xrange_major_minor_only)
 
 TEST_F(test_range_bounds, xrange_wildcard_on_major)
 {
-	const lexer::parts p {"*", "*", false, "", "*", "", "", "", ""};
+	const lexer::parts p {"*", "*", false, "", "*", "", "", "", "",
+		true, false, false, 0, 0, 0};
 
 	EXPECT_EQ(semver::min(), lower_bound(p));
 	EXPECT_EQ(semver::max(), upper_bound(p));
@@ -142,7 +166,8 @@ TEST_F(test_range_bounds, xrange_wildcard_on_major)
 
 TEST_F(test_range_bounds, xrange_wildcard_on_minor)
 {
-	const lexer::parts p {"1.*", "1.*", false, "", "1", "*", "", "", ""};
+	const lexer::parts p {"1.*", "1.*", false, "", "1", "*", "", "", "",
+		false, true, false, 1, 0, 0};
 
 	EXPECT_EQ(semver("1.0.0"), lower_bound(p));
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p));
@@ -150,7 +175,8 @@ TEST_F(test_range_bounds, xrange_wildcard_on_minor)
 
 TEST_F(test_range_bounds, xrange_wildcard_on_major_only)
 {
-	const lexer::parts p {"*.2.3", "*.2.3", false, "", "*", "2", "3", "", ""};
+	const lexer::parts p {"*.2.3", "*.2.3", false, "", "*", "2", "3", "", "",
+		true, false, false, 0, 2, 3};
 
 	EXPECT_EQ(semver::min(), lower_bound(p));
 	EXPECT_EQ(semver::max(), upper_bound(p));
@@ -158,7 +184,8 @@ TEST_F(test_range_bounds, xrange_wildcard_on_major_only)
 
 TEST_F(test_range_bounds, xrange_wildcard_on_minor_only)
 {
-	const lexer::parts p {"1.*.3", "1.*.3", false, "", "1", "*", "3", "", ""};
+	const lexer::parts p {"1.*.3", "1.*.3", false, "", "1", "*", "3", "", "",
+		false, true, false, 1, 0, 3};
 
 	EXPECT_EQ(semver("1.0.0"), lower_bound(p));
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p));
@@ -166,7 +193,8 @@ TEST_F(test_range_bounds, xrange_wildcard_on_minor_only)
 
 TEST_F(test_range_bounds, xrange_wildcard_on_patch_only)
 {
-	const lexer::parts p {"1.2.*", "1.2.*", false, "", "1", "2", "*", "", ""};
+	const lexer::parts p {"1.2.*", "1.2.*", false, "", "1", "2", "*", "", "",
+		false, false, true, 1, 2, 0};
 
 	EXPECT_EQ(semver("1.2.0"), lower_bound(p));
 	EXPECT_EQ(semver("1.3.0-0"), upper_bound(p));
@@ -174,7 +202,8 @@ TEST_F(test_range_bounds, xrange_wildcard_on_patch_only)
 
 TEST_F(test_range_bounds, xrange_wildcard_on_minor_and_patch)
 {
-	const lexer::parts p {"1.*.*", "1.*.*", false, "", "1", "*", "*", "", ""};
+	const lexer::parts p {"1.*.*", "1.*.*", false, "", "1", "*", "*", "", "",
+		false, true, true, 1, 0, 0};
 
 	EXPECT_EQ(semver("1.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -182,7 +211,8 @@ TEST_F(test_range_bounds, xrange_wildcard_on_minor_and_patch)
 
 TEST_F(test_range_bounds, xrange_wildcard_on_major_and_minor_and_patch)
 {
-	const lexer::parts p {"*.*.*", "*.*.*", false, "", "*", "*", "*", "", ""};
+	const lexer::parts p {"*.*.*", "*.*.*", false, "", "*", "*", "*", "", "",
+		true, true, true, 0, 0, 0};
 
 	EXPECT_EQ(semver::min(), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver::max(), upper_bound(p)) << "token=" << p.token;
@@ -190,7 +220,8 @@ TEST_F(test_range_bounds, xrange_wildcard_on_major_and_minor_and_patch)
 
 TEST_F(test_range_bounds, tilderange_major_minor_patch_1)
 {
-	const lexer::parts p {"~1.2.3", "1.2.3", true, "~", "1", "2", "3", "", ""};
+	const lexer::parts p {"~1.2.3", "1.2.3", true, "~", "1", "2", "3", "", "",
+		false, false, false, 1, 2, 3};
 
 	EXPECT_EQ(semver("1.2.3"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.3.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -198,7 +229,8 @@ TEST_F(test_range_bounds, tilderange_major_minor_patch_1)
 
 TEST_F(test_range_bounds, tilderange_major_minor_patch_2)
 {
-	const lexer::parts p {"~0.2.3", "0.2.3", true, "~", "0", "2", "3", "", ""};
+	const lexer::parts p {"~0.2.3", "0.2.3", true, "~", "0", "2", "3", "", "",
+		false, false, false, 0, 2, 3};
 
 	EXPECT_EQ(semver("0.2.3"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("0.3.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -206,7 +238,8 @@ TEST_F(test_range_bounds, tilderange_major_minor_patch_2)
 
 TEST_F(test_range_bounds, tilderange_major_minor_1)
 {
-	const lexer::parts p {"~1.2", "1.2", false, "~", "1", "2", "", "", ""};
+	const lexer::parts p {"~1.2", "1.2", false, "~", "1", "2", "", "", "",
+		false, false, false, 1, 2, 0};
 
 	EXPECT_EQ(semver("1.2.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.3.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -214,7 +247,8 @@ TEST_F(test_range_bounds, tilderange_major_minor_1)
 
 TEST_F(test_range_bounds, tilderange_major_minor_2)
 {
-	const lexer::parts p {"~0.2", "0.2", false, "~", "0", "2", "", "", ""};
+	const lexer::parts p {"~0.2", "0.2", false, "~", "0", "2", "", "", "",
+		false, false, false, 0, 2, 0};
 
 	EXPECT_EQ(semver("0.2.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("0.3.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -222,7 +256,8 @@ TEST_F(test_range_bounds, tilderange_major_minor_2)
 
 TEST_F(test_range_bounds, tilderange_major_1)
 {
-	const lexer::parts p {"~1", "1", false, "~", "1", "", "", "", ""};
+	const lexer::parts p {"~1", "1", false, "~", "1", "", "", "", "",
+		false, false, false, 1, 0, 0};
 
 	EXPECT_EQ(semver("1.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -230,7 +265,8 @@ TEST_F(test_range_bounds, tilderange_major_1)
 
 TEST_F(test_range_bounds, tilderange_major_2)
 {
-	const lexer::parts p {"~0", "0", false, "~", "0", "", "", "", ""};
+	const lexer::parts p {"~0", "0", false, "~", "0", "", "", "", "",
+		false, false, false, 0, 0, 0};
 
 	EXPECT_EQ(semver("0.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -238,7 +274,8 @@ TEST_F(test_range_bounds, tilderange_major_2)
 
 TEST_F(test_range_bounds, tilderange_major_minor_patch_prerelease)
 {
-	const lexer::parts p {"~1.2.3-beta.2", "1.2.3-beta.2", true, "~", "1", "2", "3", "beta.2", ""};
+	const lexer::parts p {"~1.2.3-beta.2", "1.2.3-beta.2", true, "~", "1", "2", "3", "beta.2", "",
+		false, false, false, 1, 2, 3};
 
 	EXPECT_EQ(semver("1.2.3-beta.2"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.3.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -246,7 +283,8 @@ TEST_F(test_range_bounds, tilderange_major_minor_patch_prerelease)
 
 TEST_F(test_range_bounds, caretrange_major_minor_patch)
 {
-	const lexer::parts p {"^1.2.3", "1.2.3", true, "^", "1", "2", "3", "", ""};
+	const lexer::parts p {"^1.2.3", "1.2.3", true, "^", "1", "2", "3", "", "",
+		false, false, false, 1, 2, 3};
 
 	EXPECT_EQ(semver("1.2.3"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -254,7 +292,8 @@ TEST_F(test_range_bounds, caretrange_major_minor_patch)
 
 TEST_F(test_range_bounds, caretrange_major_minor_patch_with_xrange_1)
 {
-	const lexer::parts p {"^1.2.*", "1.2.*", false, "^", "1", "2", "*", "", ""};
+	const lexer::parts p {"^1.2.*", "1.2.*", false, "^", "1", "2", "*", "", "",
+		false, false, true, 1, 2, 0};
 
 	EXPECT_EQ(semver("1.2.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -262,7 +301,8 @@ TEST_F(test_range_bounds, caretrange_major_minor_patch_with_xrange_1)
 
 TEST_F(test_range_bounds, caretrange_major_minor_patch_with_xrange_2)
 {
-	const lexer::parts p {"^0.0.*", "0.0.*", false, "^", "0", "0", "*", "", ""};
+	const lexer::parts p {"^0.0.*", "0.0.*", false, "^", "0", "0", "*", "", "",
+		false, false, true, 0, 0, 0};
 
 	EXPECT_EQ(semver("0.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("0.1.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -270,7 +310,8 @@ TEST_F(test_range_bounds, caretrange_major_minor_patch_with_xrange_2)
 
 TEST_F(test_range_bounds, caretrange_major_minor_1)
 {
-	const lexer::parts p {"^0.0", "0.0", false, "^", "0", "0", "", "", ""};
+	const lexer::parts p {"^0.0", "0.0", false, "^", "0", "0", "", "", "",
+		false, false, false, 0, 0, 0};
 
 	EXPECT_EQ(semver("0.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("0.1.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -278,7 +319,8 @@ TEST_F(test_range_bounds, caretrange_major_minor_1)
 
 TEST_F(test_range_bounds, caretrange_major_minor_with_xrange_1)
 {
-	const lexer::parts p {"^1.*", "1.*", false, "^", "1", "*", "", "", ""};
+	const lexer::parts p {"^1.*", "1.*", false, "^", "1", "*", "", "", "",
+		false, true, false, 1, 0, 0};
 
 	EXPECT_EQ(semver("1.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -286,7 +328,8 @@ TEST_F(test_range_bounds, caretrange_major_minor_with_xrange_1)
 
 TEST_F(test_range_bounds, caretrange_major_minor_with_xrange_2)
 {
-	const lexer::parts p {"^0.*", "0.*", false, "^", "0", "*", "", "", ""};
+	const lexer::parts p {"^0.*", "0.*", false, "^", "0", "*", "", "", "",
+		false, true, false, 0, 0, 0};
 
 	EXPECT_EQ(semver("0.0.0"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("1.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -294,7 +337,8 @@ TEST_F(test_range_bounds, caretrange_major_minor_with_xrange_2)
 
 TEST_F(test_range_bounds, caretrange_major0_minor_patch)
 {
-	const lexer::parts p {"^0.2.3", "0.2.3", true, "^", "0", "2", "3", "", ""};
+	const lexer::parts p {"^0.2.3", "0.2.3", true, "^", "0", "2", "3", "", "",
+		false, false, false, 0, 2, 3};
 
 	EXPECT_EQ(semver("0.2.3"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("0.3.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -302,7 +346,8 @@ TEST_F(test_range_bounds, caretrange_major0_minor_patch)
 
 TEST_F(test_range_bounds, caretrange_major0_minor0_patch)
 {
-	const lexer::parts p {"^0.0.3", "0.0.3", true, "^", "0", "0", "3", "", ""};
+	const lexer::parts p {"^0.0.3", "0.0.3", true, "^", "0", "0", "3", "", "",
+		false, false, false, 0, 0, 3};
 
 	EXPECT_EQ(semver("0.0.3"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("0.0.4-0"), upper_bound(p)) << "token=" << p.token;
@@ -310,7 +355,8 @@ TEST_F(test_range_bounds, caretrange_major0_minor0_patch)
 
 TEST_F(test_range_bounds, caretrange_major_minor_patch_prerelease_1)
 {
-	const lexer::parts p {"^1.2.3-beta.2", "1.2.3-beta.2", true, "^", "1", "2", "3", "beta.2", ""};
+	const lexer::parts p {"^1.2.3-beta.2", "1.2.3-beta.2", true, "^", "1", "2", "3", "beta.2", "",
+		false, false, false, 1, 2, 3};
 
 	EXPECT_EQ(semver("1.2.3-beta.2"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("2.0.0-0"), upper_bound(p)) << "token=" << p.token;
@@ -318,7 +364,8 @@ TEST_F(test_range_bounds, caretrange_major_minor_patch_prerelease_1)
 
 TEST_F(test_range_bounds, caretrange_major_minor_patch_prerelease_2)
 {
-	const lexer::parts p {"^0.0.3-beta", "0.0.3-beta", true, "^", "0", "0", "3", "beta", ""};
+	const lexer::parts p {"^0.0.3-beta", "0.0.3-beta", true, "^", "0", "0", "3", "beta", "",
+		false, false, false, 0, 0, 3};
 
 	EXPECT_EQ(semver("0.0.3-beta"), lower_bound(p)) << "token=" << p.token;
 	EXPECT_EQ(semver("0.0.4-0"), upper_bound(p)) << "token=" << p.token;
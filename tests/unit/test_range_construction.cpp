@@ -3,7 +3,48 @@
 
 namespace
 {
+using semver::inclusivity;
 using semver::range;
+using semver::range_limits;
+using semver::semver;
+
+std::string many_alternatives(std::size_t n)
+{
+	std::string s;
+	for (std::size_t i = 0; i < n; ++i) {
+		if (i > 0)
+			s += " || ";
+		s += "1.0." + std::to_string(i);
+	}
+	return s;
+}
+
+std::string many_comparators(std::size_t n)
+{
+	std::string s;
+	for (std::size_t i = 0; i < n; ++i) {
+		if (i > 0)
+			s += ' ';
+		s += ">=1.0." + std::to_string(i);
+	}
+	return s;
+}
+
+// Checks that the built range is the same as the parsed one, not only equivalent.
+void expect_parsed(const range & built, const std::string & text)
+{
+	const auto parsed = range(text);
+	ASSERT_TRUE(parsed.ok()) << text;
+	ASSERT_TRUE(built.ok()) << text;
+	EXPECT_EQ(to_string(parsed), to_string(built)) << text;
+	EXPECT_TRUE(parsed == built) << text;
+	EXPECT_EQ(parsed.min(), built.min()) << text;
+	EXPECT_EQ(parsed.max(), built.max()) << text;
+}
+
+const char * const builder_versions[] = {"0.0.0", "0.0.7", "0.3.0", "0.3.7", "1.0.0",
+	"1.2.3", "1.2.3-rc.1", "0.0.0-alpha", "0.0.4-beta.2", "0.5.0-0", "2.0.0+build.5",
+	"3.4.5-rc.1+sha.1", "18446744073709551614.1.2"};
 
 class test_range_construction : public ::testing::Test {};
 
@@ -314,5 +355,227 @@ TEST_F(test_range_construction, caret_x_ranges_5)
 
 	ASSERT_TRUE(r.ok());
 }
+
+TEST_F(test_range_construction, invalid_hyphen_range)
+{
+	const auto r = range("1.2.3 - ^2.0.0");
+
+	ASSERT_FALSE(r.ok());
+}
+
+TEST_F(test_range_construction, many_alternatives)
+{
+	const auto r = range(many_alternatives(100000));
+
+	ASSERT_TRUE(r.ok());
+	EXPECT_TRUE(r.satisfies(::semver::semver(1, 0, 99999)));
+	EXPECT_FALSE(r.satisfies(::semver::semver(1, 0, 100000)));
+}
+
+TEST_F(test_range_construction, many_comparators)
+{
+	const auto r = range(many_comparators(100000));
+
+	ASSERT_TRUE(r.ok());
+	EXPECT_TRUE(r.satisfies(::semver::semver(1, 0, 99999)));
+	EXPECT_FALSE(r.satisfies(::semver::semver(1, 0, 99998)));
+}
+
+TEST_F(test_range_construction, limit_length)
+{
+	range_limits limits;
+	limits.max_length = 10u;
+
+	EXPECT_TRUE(range("1.2.3", limits).ok());
+	EXPECT_FALSE(range("1.2.3 - 2.0", limits).ok());
+	EXPECT_FALSE(range(many_alternatives(1000), limits).ok());
+}
+
+TEST_F(test_range_construction, limit_clauses)
+{
+	range_limits limits;
+	limits.max_clauses = 3u;
+
+	EXPECT_TRUE(range(many_alternatives(3), limits).ok());
+	EXPECT_FALSE(range(many_alternatives(4), limits).ok());
+	EXPECT_FALSE(range(many_alternatives(100000), limits).ok());
+}
+
+TEST_F(test_range_construction, limit_comparators)
+{
+	range_limits limits;
+	limits.max_comparators = 3u;
+
+	EXPECT_TRUE(range(many_comparators(3), limits).ok());
+	EXPECT_TRUE(range(many_comparators(3) + " || " + many_comparators(3), limits).ok());
+	EXPECT_FALSE(range(many_comparators(4), limits).ok());
+	EXPECT_FALSE(range(many_comparators(100000), limits).ok());
+}
+
+TEST_F(test_range_construction, builder_caret_tilde_exact)
+{
+	for (const auto * text : builder_versions) {
+		const auto v = semver(text);
+		ASSERT_TRUE(v.ok()) << text;
+		expect_parsed(range::caret(v), std::string("^") + text);
+		expect_parsed(range::tilde(v), std::string("~") + text);
+		expect_parsed(range::exact(v), std::string("=") + text);
+		expect_parsed(range::exact(v), text);
+	}
+}
+
+TEST_F(test_range_construction, builder_between)
+{
+	const auto lo = semver("1.2.3-rc.1+build");
+	const auto hi = semver("2.0.0");
+
+	expect_parsed(range::between(lo, hi), ">=1.2.3-rc.1 <2.0.0");
+	expect_parsed(range::between(lo, hi, inclusivity::right_open), ">=1.2.3-rc.1 <2.0.0");
+	expect_parsed(range::between(lo, hi, inclusivity::closed), ">=1.2.3-rc.1 <=2.0.0");
+	expect_parsed(range::between(lo, hi, inclusivity::open), ">1.2.3-rc.1 <2.0.0");
+	expect_parsed(range::between(lo, hi, inclusivity::left_open), ">1.2.3-rc.1 <=2.0.0");
+	expect_parsed(range::between(hi, lo), ">=2.0.0 <1.2.3-rc.1");
+}
+
+TEST_F(test_range_construction, builder_any_of)
+{
+	expect_parsed(range::any_of({range::caret(semver("1.2.3"))}), "^1.2.3");
+	expect_parsed(range::any_of({range::tilde(semver("2.1.0")), range::caret(semver("1.2.3")),
+					  range::exact(semver("0.0.1"))}),
+		"~2.1.0 || ^1.2.3 || 0.0.1");
+	expect_parsed(range::any_of({range("<1.0.0 || >=3.0.0"), range::exact(semver("2.0.0"))}),
+		"<1.0.0 || >=3.0.0 || 2.0.0");
+
+	std::vector<range> ranges;
+	ranges.push_back(range::between(semver("1.0.0"), semver("1.5.0")));
+	ranges.push_back(range::caret(semver("0.2.0")));
+	expect_parsed(range::any_of(ranges), ">=1.0.0 <1.5.0 || ^0.2.0");
+}
+
+TEST_F(test_range_construction, builder_all_of)
+{
+	expect_parsed(range::all_of({range::caret(semver("1.2.3"))}), "^1.2.3");
+	expect_parsed(range::all_of({range::caret(semver("1.2.3")), range::tilde(semver("1.4.0"))}),
+		"^1.2.3 ~1.4.0");
+	expect_parsed(range::all_of({range::between(semver("1.0.0"), semver("2.0.0")),
+					  range::exact(semver("1.5.0"))}),
+		">=1.0.0 <2.0.0 1.5.0");
+	expect_parsed(range::all_of({range("^1.0.0 || ^2.0.0"), range("<1.5.0 || >2.5.0")}),
+		"^1.0.0 <1.5.0 || ^1.0.0 >2.5.0 || ^2.0.0 <1.5.0 || ^2.0.0 >2.5.0");
+
+	std::vector<range> ranges;
+	ranges.push_back(range::caret(semver("0.3.1")));
+	ranges.push_back(range(">=0.3.2"));
+	expect_parsed(range::all_of(ranges), "^0.3.1 >=0.3.2");
+}
+
+TEST_F(test_range_construction, builder_all_of_limits)
+{
+	const auto a = range("1.0.0 || 2.0.0 || 3.0.0");
+	const auto b = range(">=1.0.0 <2.0.0 || >=3.0.0");
+
+	auto limits = ::semver::range_limits {};
+	limits.max_clauses = 6u;
+	EXPECT_TRUE(range::all_of({a, b}, limits).ok());
+	limits.max_clauses = 5u;
+	EXPECT_FALSE(range::all_of({a, b}, limits).ok());
+
+	// the product of many ranges is rejected before it is built
+	const auto ranges = std::vector<range>(64u, b);
+	EXPECT_FALSE(range::all_of(ranges, limits).ok());
+
+	limits = {};
+	limits.max_comparators = 3u;
+	EXPECT_TRUE(range::all_of({a, b}, limits).ok());
+	limits.max_comparators = 2u;
+	EXPECT_FALSE(range::all_of({a, b}, limits).ok());
 }
 
+TEST_F(test_range_construction, builder_named_ranges)
+{
+	const auto a = range::caret(semver("1.2.3"));
+	const auto b = range("~2.1.0 || 0.0.1");
+	const auto c = range(">=1.5.0");
+
+	expect_parsed(range::any_of({a, b}), "^1.2.3 || ~2.1.0 || 0.0.1");
+	expect_parsed(range::all_of({a, c}), "^1.2.3 >=1.5.0");
+	// alternatives of a range are sorted, `b` is `=0.0.1 || >=2.1.0 <2.2.0-0`
+	expect_parsed(range::all_of({b, c}), "0.0.1 >=1.5.0 || ~2.1.0 >=1.5.0");
+
+	// the arguments are unchanged
+	expect_parsed(a, "^1.2.3");
+	expect_parsed(b, "~2.1.0 || 0.0.1");
+}
+
+TEST_F(test_range_construction, copy)
+{
+	const auto r = range(">=1.2.3 <2.0.0 || ~3.1.0-rc.1");
+	auto c = r;
+	expect_parsed(c, ">=1.2.3 <2.0.0 || ~3.1.0-rc.1");
+
+	c = range("^4.0.0");
+	expect_parsed(c, "^4.0.0");
+	c = r;
+	expect_parsed(c, ">=1.2.3 <2.0.0 || ~3.1.0-rc.1");
+
+	const auto invalid = range("foo");
+	const auto d = invalid;
+	EXPECT_FALSE(d.ok());
+}
+
+TEST_F(test_range_construction, builder_invalid)
+{
+	const auto invalid = semver("1.2");
+	ASSERT_FALSE(invalid.ok());
+
+	EXPECT_FALSE(range::caret(invalid).ok());
+	EXPECT_FALSE(range::tilde(invalid).ok());
+	EXPECT_FALSE(range::exact(invalid).ok());
+	EXPECT_FALSE(range::between(invalid, semver("2.0.0")).ok());
+	EXPECT_FALSE(range::between(semver("1.0.0"), invalid).ok());
+	EXPECT_FALSE(range::any_of({}).ok());
+	EXPECT_FALSE(range::all_of({}).ok());
+	EXPECT_FALSE(range::any_of({range::caret(semver("1.0.0")), range("^")}).ok());
+	EXPECT_FALSE(range::all_of({range::caret(semver("1.0.0")), range::exact(invalid)}).ok());
+	EXPECT_FALSE(range::caret(invalid).satisfies(semver("1.2.0")));
+}
+
+TEST_F(test_range_construction, builder_satisfies)
+{
+	const auto r = range::all_of(
+		{range::any_of({range::caret(semver("1.2.0")), range::tilde(semver("3.1.0"))}),
+			range::between(semver("1.0.0"), semver("3.1.5"), inclusivity::closed)});
+
+	EXPECT_TRUE(r.satisfies(semver("1.2.0")));
+	EXPECT_TRUE(r.satisfies(semver("1.9.9")));
+	EXPECT_TRUE(r.satisfies(semver("3.1.5")));
+	EXPECT_FALSE(r.satisfies(semver("3.1.6")));
+	EXPECT_FALSE(r.satisfies(semver("2.0.0")));
+	EXPECT_FALSE(r.satisfies(semver("1.1.9")));
+}
+
+TEST_F(test_range_construction, alternatives_order_independent)
+{
+	// overlapping alternatives of comparators, in ascending and descending order
+	std::vector<std::string> alternatives;
+	for (int i = 0; i < 200; ++i) {
+		const auto lower = std::to_string(i % 7) + "." + std::to_string(i % 13) + ".0";
+		const auto upper = std::to_string(i % 7 + 1 + i % 3) + ".0.0";
+		alternatives.push_back(">=" + lower + " <" + upper);
+	}
+	std::string forward;
+	std::string backward;
+	for (std::size_t i = 0; i < alternatives.size(); ++i) {
+		forward += (i > 0 ? " || " : "") + alternatives[i];
+		backward += (i > 0 ? " || " : "") + alternatives[alternatives.size() - 1 - i];
+	}
+
+	const auto a = range(forward);
+	const auto b = range(backward);
+	ASSERT_TRUE(a.ok());
+	ASSERT_TRUE(b.ok());
+	EXPECT_TRUE(a == b);
+	EXPECT_TRUE(range(">=1.0.0 <3.0.0 || >=2.0.0 <2.5.0")
+		== range(">=2.0.0 <2.5.0 || >=1.0.0 <3.0.0"));
+}
+}
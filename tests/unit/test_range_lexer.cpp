@@ -1,5 +1,6 @@
 #include "detail/range_lexer.hpp"
 #include <gtest/gtest.h>
+#include <limits>
 
 #define EXPECT_SV(s, e) EXPECT_EQ(std::string_view(s), (e))
 
@@ -100,6 +101,73 @@ TEST_F(test_range_lexer, partial)
 	EXPECT_EQ(lexer::token::eof, l.scan());
 }
 
+TEST_F(test_range_lexer, partial_wildcards)
+{
+	lexer l("x.X.*");
+
+	EXPECT_EQ(lexer::token::partial, l.scan());
+	EXPECT_SV("x", l.text().major);
+	EXPECT_SV("X", l.text().minor);
+	EXPECT_SV("*", l.text().patch);
+	EXPECT_TRUE(l.text().major_wildcard);
+	EXPECT_TRUE(l.text().minor_wildcard);
+	EXPECT_TRUE(l.text().patch_wildcard);
+	EXPECT_FALSE(l.text().full_version);
+	EXPECT_EQ(lexer::token::eof, l.scan());
+}
+
+TEST_F(test_range_lexer, partial_no_wildcards)
+{
+	lexer l("1.2.3");
+
+	EXPECT_EQ(lexer::token::partial, l.scan());
+	EXPECT_FALSE(l.text().major_wildcard);
+	EXPECT_FALSE(l.text().minor_wildcard);
+	EXPECT_FALSE(l.text().patch_wildcard);
+	EXPECT_EQ(lexer::token::eof, l.scan());
+}
+
+TEST_F(test_range_lexer, partial_numbers)
+{
+	lexer l("10.200.3000 1.x 18446744073709551615.0.0");
+
+	EXPECT_EQ(lexer::token::partial, l.scan());
+	EXPECT_EQ(10u, l.text().major_number);
+	EXPECT_EQ(200u, l.text().minor_number);
+	EXPECT_EQ(3000u, l.text().patch_number);
+	EXPECT_TRUE(l.text().full_version);
+
+	EXPECT_EQ(lexer::token::partial, l.scan());
+	EXPECT_EQ(1u, l.text().major_number);
+	EXPECT_EQ(0u, l.text().minor_number);
+	EXPECT_EQ(0u, l.text().patch_number);
+	EXPECT_FALSE(l.text().full_version);
+
+	if (std::numeric_limits<::semver::semver::number_type>::max() == 18446744073709551615ul) {
+		EXPECT_EQ(lexer::token::partial, l.scan());
+		EXPECT_EQ(18446744073709551615ul, l.text().major_number);
+	}
+}
+
+TEST_F(test_range_lexer, partial_number_overflow)
+{
+	lexer l("1.184467440737095516150.0");
+
+	EXPECT_EQ(lexer::token::error, l.scan());
+}
+
+TEST_F(test_range_lexer, texts_are_views_into_data)
+{
+	const std::string s = ">=1.2.3-pre+build";
+	lexer l(s);
+
+	EXPECT_EQ(lexer::token::op_partial, l.scan());
+	EXPECT_EQ(s.data(), l.text().token.data());
+	EXPECT_EQ(s.data() + 2, l.text().major.data());
+	EXPECT_SV("pre", l.text().prerelease);
+	EXPECT_SV("build", l.text().build);
+}
+
 TEST_F(test_range_lexer, caret_partial)
 {
 	lexer l("^1.2.3");
@@ -287,5 +287,51 @@ TEST_F(test_range_node, less_nonleafs_diff_3)
 	EXPECT_FALSE(node::less(n1, n2));
 	EXPECT_TRUE(node::less(n2, n1));
 }
+
+TEST_F(test_range_node, less_nonleafs_lexicographic)
+{
+	const auto n1 = node::create_and(
+		node::create_ge(semver("1.0.0")),
+		node::create_lt(semver("3.0.0")));
+	const auto n2 = node::create_and(
+		node::create_ge(semver("2.0.0")),
+		node::create_lt(semver("2.5.0")));
+
+	EXPECT_TRUE(node::less(n1, n2));
+	EXPECT_FALSE(node::less(n2, n1));
 }
 
+TEST_F(test_range_node, less_nonleafs_size)
+{
+	const auto n1 = node::create_and(
+		node::create_ge(semver("2.0.0")),
+		node::create_lt(semver("3.0.0")));
+	auto leafs = std::vector<std::unique_ptr<node>> {};
+	leafs.push_back(std::make_unique<node>(node::create_ge(semver("1.0.0"))));
+	leafs.push_back(std::make_unique<node>(node::create_lt(semver("4.0.0"))));
+	leafs.push_back(std::make_unique<node>(node::create_lt(semver("5.0.0"))));
+	const auto n2 = node::create_and_of_leafs(std::move(leafs));
+
+	EXPECT_TRUE(node::less(n1, n2));
+	EXPECT_FALSE(node::less(n2, n1));
+}
+
+TEST_F(test_range_node, less_leafs_operator)
+{
+	const auto n1 = node::create_ge(semver("1.5.0"));
+	const auto n2 = node::create_le(semver("1.5.0"));
+
+	EXPECT_NE(node::less(n1, n2), node::less(n2, n1));
+}
+
+TEST_F(test_range_node, less_leafs_leading_zeros)
+{
+	const auto n1 = node::create_eq(semver("1.5.0-01"));
+	const auto n2 = node::create_eq(semver("1.5.0-1"));
+	const auto n3 = node::create_eq(semver("1.5.0-2"));
+
+	EXPECT_NE(node::less(n1, n2), node::less(n2, n1));
+	EXPECT_TRUE(node::less(n1, n3));
+	EXPECT_TRUE(node::less(n2, n3));
+}
+}
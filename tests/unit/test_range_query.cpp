@@ -1,11 +1,72 @@
 #include <semver/range.hpp>
+#include <semver/binary.hpp>
 #include <gtest/gtest.h>
+#include <array>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace
 {
 using semver::range;
+using semver::satisfying;
+using semver::semver_view;
+using semver::version_tuple;
 using semver::semver;
 
+// Single pass iterator parsing versions of lines on the fly.
+class line_iterator final
+{
+public:
+	using iterator_category = std::input_iterator_tag;
+	using value_type = semver;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const semver *;
+	using reference = const semver &;
+
+	line_iterator() = default;
+
+	explicit line_iterator(std::string_view text, int * reads)
+		: text_(text)
+		, reads_(reads)
+	{
+		read();
+	}
+
+	reference operator*() const { return current_; }
+	pointer operator->() const { return &current_; }
+
+	line_iterator & operator++()
+	{
+		read();
+		return *this;
+	}
+
+	friend bool operator==(const line_iterator & a, const line_iterator & b)
+	{
+		return a.end_ == b.end_;
+	}
+	friend bool operator!=(const line_iterator & a, const line_iterator & b) { return !(a == b); }
+
+private:
+	std::string_view text_;
+	int * reads_ = nullptr;
+	semver current_;
+	bool end_ = true;
+
+	void read()
+	{
+		end_ = text_.empty();
+		if (end_)
+			return;
+		const auto n = text_.find('\n');
+		current_ = semver(std::string(text_.substr(0, n)));
+		text_ = (n == std::string_view::npos) ? std::string_view {} : text_.substr(n + 1);
+		++*reads_;
+	}
+};
+
 class test_range_query : public ::testing::Test {};
 
 TEST_F(test_range_query, outside_greater)
@@ -290,6 +351,79 @@ TEST_F(test_range_query, satisfies_xrange_major_wildminor)
 	EXPECT_FALSE(r.satisfies(semver("2.0.0")));
 }
 
+TEST_F(test_range_query, satisfies_text)
+{
+	const auto r = range(">=1.2.3-alpha.2 <2.0.0 || 3.0.0");
+
+	EXPECT_TRUE(r.satisfies(std::string_view("1.2.3-alpha.2")));
+	EXPECT_TRUE(r.satisfies(std::string_view("1.2.3-alpha.10+build")));
+	EXPECT_TRUE(r.satisfies(std::string_view("1.9.9")));
+	EXPECT_TRUE(r.satisfies(std::string_view("3.0.0")));
+	EXPECT_TRUE(r.satisfies("3.0.0+build.1"));
+	EXPECT_TRUE(r.satisfies(std::string("1.5.0")));
+	EXPECT_FALSE(r.satisfies(std::string_view("1.2.3-alpha.1")));
+	EXPECT_FALSE(r.satisfies(std::string_view("2.0.0")));
+	EXPECT_FALSE(r.satisfies(std::string_view("3.0.0-rc.1")));
+}
+
+TEST_F(test_range_query, satisfies_text_invalid)
+{
+	const auto r = range("*");
+
+	for (const auto * s : {"", "foo", "1.2", "1.2.3.4", "01.2.3", "1.2.3-", "1.2.3+", "1.2.3 ",
+			 " 1.2.3", "v1.2.3", "1.2.3-a..b"})
+		EXPECT_FALSE(r.satisfies(std::string_view(s))) << s;
+}
+
+TEST_F(test_range_query, satisfies_text_same_as_version)
+{
+	const char * ranges[] = {"*", "^1.2.3", "~1.2.3-beta.2", ">=1.0.0-0 <1.0.0", "1.2.3 - 2.3.4",
+		"<1.0.0 || >=3.0.0-rc.1", "=1.2.3-alpha", "foo", "1.x || 2.3.x"};
+	const char * versions[] = {"0.0.0", "1.0.0-alpha", "1.0.0-rc.1", "1.0.0", "1.2.3-alpha",
+		"1.2.3-beta.2", "1.2.3-beta.11", "1.2.3", "1.2.4", "2.3.4", "2.3.5-0", "3.0.0-rc.0",
+		"3.0.0-rc.1+b", "3.0.0", "10.0.0"};
+
+	for (const auto * rs : ranges) {
+		const auto r = range(rs);
+		for (const auto * vs : versions)
+			EXPECT_EQ(r.satisfies(semver(vs)), r.satisfies(std::string_view(vs))) << rs << " " << vs;
+	}
+}
+
+TEST_F(test_range_query, satisfies_numbers)
+{
+	const auto r = range(">=1.2.3-alpha.2 <2.0.0 || 3.0.0");
+
+	EXPECT_TRUE(r.satisfies(1, 2, 3));
+	EXPECT_TRUE(r.satisfies(1, 2, 3, "alpha.2"));
+	EXPECT_TRUE(r.satisfies(1, 2, 3, "alpha.10"));
+	EXPECT_TRUE(r.satisfies(1, 9, 9));
+	EXPECT_TRUE(r.satisfies(3, 0, 0));
+	EXPECT_FALSE(r.satisfies(1, 2, 3, "alpha.1"));
+	EXPECT_FALSE(r.satisfies(1, 2, 2));
+	EXPECT_FALSE(r.satisfies(2, 0, 0));
+	EXPECT_FALSE(r.satisfies(3, 0, 0, "rc.1"));
+	EXPECT_FALSE(range("foo").satisfies(1, 2, 3));
+}
+
+TEST_F(test_range_query, satisfies_numbers_same_as_version)
+{
+	const char * ranges[] = {"*", "^1.2.3", "~1.2.3-beta.2", ">=1.0.0-0 <1.0.0", "1.2.3 - 2.3.4",
+		"<1.0.0 || >=3.0.0-rc.1", "=1.2.3-alpha", "1.x || 2.3.x"};
+	const char * versions[] = {"0.0.0", "1.0.0-alpha", "1.0.0-rc.1", "1.0.0", "1.2.3-alpha",
+		"1.2.3-beta.2", "1.2.3-beta.11", "1.2.3", "1.2.4", "2.3.4", "2.3.5-0", "3.0.0-rc.0",
+		"3.0.0", "10.0.0"};
+
+	for (const auto * rs : ranges) {
+		const auto r = range(rs);
+		for (const auto * vs : versions) {
+			const auto v = semver(vs);
+			const auto t = version_tuple(v.major(), v.minor(), v.patch(), v.prerelease());
+			EXPECT_EQ(r.satisfies(v), r.satisfies(t)) << rs << " " << vs;
+		}
+	}
+}
+
 TEST_F(test_range_query, max)
 {
 	EXPECT_EQ(semver("2.0.0"), range("2.0.0").max());
@@ -386,5 +520,197 @@ TEST_F(test_range_query, min_satisfying_empty_list)
 	EXPECT_FALSE(v.ok());
 	EXPECT_EQ(semver(), v);
 }
+
+TEST_F(test_range_query, max_min_satisfying_iterators)
+{
+	const auto r = range(">1.2.3 <2.0.0 || 3.0.0");
+	const semver versions[] = {semver("1.5.0"), semver("3.0.0"), semver("1.11.0"), semver("2.0.0")};
+
+	EXPECT_EQ(semver("3.0.0"), r.max_satisfying(std::begin(versions), std::end(versions)));
+	EXPECT_EQ(semver("1.5.0"), r.min_satisfying(std::begin(versions), std::end(versions)));
+	EXPECT_EQ(semver("1.11.0"), r.max_satisfying(std::begin(versions) + 2, std::end(versions)));
+	EXPECT_FALSE(r.max_satisfying(std::begin(versions), std::begin(versions)).ok());
+}
+
+TEST_F(test_range_query, max_min_satisfying_containers)
+{
+	const auto r = range("^1.2.0");
+	const auto a = std::array<semver, 3> {semver("1.2.0"), semver("1.9.9"), semver("2.0.0")};
+	const semver c[] = {semver("0.9.0"), semver("1.4.0")};
+
+	EXPECT_EQ(semver("1.9.9"), r.max_satisfying(a));
+	EXPECT_EQ(semver("1.2.0"), r.min_satisfying(a));
+	EXPECT_EQ(semver("1.4.0"), r.max_satisfying(c));
+	EXPECT_FALSE(r.min_satisfying(std::array<semver, 0> {}).ok());
+}
+
+TEST_F(test_range_query, max_min_satisfying_first_of_equal_precedence)
+{
+	const auto r = range("^1.0.0");
+	const auto versions = std::vector<semver> {semver("1.0.0+a"), semver("1.0.0+b")};
+
+	EXPECT_EQ("a", r.max_satisfying(begin(versions), end(versions)).build());
+	EXPECT_EQ("a", r.min_satisfying(begin(versions), end(versions)).build());
+}
+
+TEST_F(test_range_query, max_min_satisfying_single_pass)
+{
+	const auto r = range("~1.2.0");
+	const std::string_view text = "1.2.0\n1.3.0\nfoo\n1.2.7\n1.2.3";
+
+	int reads = 0;
+	const auto v = r.max_satisfying(line_iterator(text, &reads), line_iterator());
+	EXPECT_EQ(semver("1.2.7"), v);
+	EXPECT_EQ(5, reads);
+
+	reads = 0;
+	EXPECT_EQ(semver("1.2.0"), r.min_satisfying(line_iterator(text, &reads), line_iterator()));
+	EXPECT_EQ(5, reads);
+}
+
+TEST_F(test_range_query, max_min_satisfying_views)
+{
+	std::string buf;
+	for (const auto * s : {"1.2.0", "1.3.0-rc.1", "1.3.0", "2.0.0"})
+		ASSERT_TRUE(encode(semver(s), buf));
+
+	std::vector<semver_view> views;
+	for (std::string_view data = buf; !data.empty();) {
+		views.push_back(semver_view(data));
+		data.remove_prefix(views.back().size());
+	}
+
+	const auto r = range("^1.2.0");
+	EXPECT_EQ(semver("1.3.0"), r.max_satisfying(views).to_semver());
+	EXPECT_EQ(semver("1.2.0"), r.min_satisfying(views).to_semver());
+	EXPECT_FALSE(range("^3.0.0").max_satisfying(views).ok());
+}
+
+TEST_F(test_range_query, satisfying_view)
+{
+	const auto r = range(">1.2.3 <2.0.0 || 3.0.0");
+	const auto versions = std::vector<semver> {semver("1.0.0"), semver("1.5.0"), semver("2.0.0"),
+		semver("3.0.0"), semver("1.2.4")};
+
+	std::vector<semver> result;
+	for (const auto & v : satisfying(r, versions))
+		result.push_back(v);
+	EXPECT_EQ((std::vector<semver> {semver("1.5.0"), semver("3.0.0"), semver("1.2.4")}), result);
+
+	const auto view = satisfying(r, versions);
+	EXPECT_EQ(3, std::distance(view.begin(), view.end()));
+	EXPECT_EQ(semver("1.5.0"), *view.begin());
+	EXPECT_EQ(5u, view.begin()->minor());
+}
+
+TEST_F(test_range_query, satisfying_view_none)
+{
+	const auto r = range("^5.0.0");
+	const auto versions = std::vector<semver> {semver("1.0.0"), semver("2.0.0")};
+
+	const auto view = satisfying(r, versions);
+	EXPECT_TRUE(view.begin() == view.end());
+}
+
+TEST_F(test_range_query, satisfying_view_single_pass)
+{
+	const auto r = range("~1.2.0");
+	const std::string_view text = "1.2.0\n1.3.0\nfoo\n1.2.7";
+
+	int reads = 0;
+	std::vector<semver> result;
+	for (const auto & v : satisfying(r, line_iterator(text, &reads), line_iterator()))
+		result.push_back(v);
+	EXPECT_EQ((std::vector<semver> {semver("1.2.0"), semver("1.2.7")}), result);
+	EXPECT_EQ(4, reads);
+}
+
+TEST_F(test_range_query, min_max_many_comparators)
+{
+	std::string s;
+	for (int i = 0; i < 10000; ++i)
+		s += ">=1.0." + std::to_string(i) + ' ';
+	const auto r = range(s);
+
+	ASSERT_TRUE(r.ok());
+	EXPECT_EQ(semver("1.0.9999"), r.min());
+	EXPECT_EQ(semver::max(), r.max());
+}
+
+TEST_F(test_range_query, min_max_unsatisfiable)
+{
+	const auto r = range(">=2.0.0 <1.0.0");
+
+	ASSERT_TRUE(r.ok());
+	EXPECT_FALSE(r.min().ok());
+	EXPECT_FALSE(r.max().ok());
+	EXPECT_FALSE(r.satisfies(semver("1.5.0")));
+}
+
+TEST_F(test_range_query, gtr)
+{
+	const auto r = range(">1.2.3 <2.0.0 || 3.0.0");
+
+	ASSERT_TRUE(r.ok());
+	EXPECT_FALSE(r.gtr(semver("1.0.0")));
+	EXPECT_FALSE(r.gtr(semver("1.2.4")));
+	EXPECT_FALSE(r.gtr(semver("2.0.0")));
+	EXPECT_FALSE(r.gtr(semver("3.0.0")));
+	EXPECT_TRUE(r.gtr(semver("3.0.1-0")));
+	EXPECT_TRUE(r.gtr(semver("3.0.1")));
+	EXPECT_TRUE(r.gtr(semver("4.0.0")));
+}
+
+TEST_F(test_range_query, gtr_exclusive)
+{
+	const auto r = range("<2.0.0");
+
+	ASSERT_TRUE(r.ok());
+	EXPECT_FALSE(r.gtr(semver("1.9.9")));
+	EXPECT_FALSE(r.gtr(semver("2.0.0-0")));
+	EXPECT_TRUE(r.gtr(semver("2.0.0")));
+}
+
+TEST_F(test_range_query, gtr_unbounded)
+{
+	EXPECT_FALSE(range(">=1.0.0").gtr(semver("999.0.0")));
+	EXPECT_FALSE(range("*").gtr(semver("999.0.0")));
+}
+
+TEST_F(test_range_query, ltr)
+{
+	const auto r = range(">1.2.3 <2.0.0 || 3.0.0");
+
+	ASSERT_TRUE(r.ok());
+	EXPECT_TRUE(r.ltr(semver("1.0.0")));
+	EXPECT_TRUE(r.ltr(semver("1.2.3")));
+	EXPECT_FALSE(r.ltr(semver("1.2.4-0")));
+	EXPECT_FALSE(r.ltr(semver("1.2.4")));
+	EXPECT_FALSE(r.ltr(semver("2.5.0")));
+	EXPECT_FALSE(r.ltr(semver("4.0.0")));
 }
 
+TEST_F(test_range_query, ltr_unbounded)
+{
+	EXPECT_FALSE(range("<1.0.0").ltr(semver("0.0.0")));
+	EXPECT_FALSE(range("*").ltr(semver("0.0.0")));
+}
+
+TEST_F(test_range_query, gtr_ltr_unsatisfiable)
+{
+	const auto r = range(">=2.0.0 <1.0.0");
+
+	ASSERT_TRUE(r.ok());
+	EXPECT_FALSE(r.gtr(semver("3.0.0")));
+	EXPECT_FALSE(r.ltr(semver("0.1.0")));
+}
+
+TEST_F(test_range_query, gtr_ltr_ignore_unsatisfiable_alternatives)
+{
+	const auto r = range(">=5.0.0 <4.0.0 || 1.x");
+
+	ASSERT_TRUE(r.ok());
+	EXPECT_TRUE(r.gtr(semver("3.0.0")));
+	EXPECT_TRUE(r.ltr(semver("0.1.0")));
+}
+}
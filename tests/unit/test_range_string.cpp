@@ -1,5 +1,7 @@
 #include <semver/range.hpp>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <sstream>
 
 namespace
 {
@@ -127,5 +129,56 @@ TEST_F(test_range_string, complex_sorted)
 
 	EXPECT_STREQ("=1.1.1 || =3.2.1 || >5.0.0 || >1.2.3 <2.3.4", s.c_str());
 }
+
+TEST_F(test_range_string, implicit_and_with_caret)
+{
+	const auto r = range("^1.2.3 <1.5.0");
+
+	ASSERT_TRUE(r.ok());
+
+	const auto s = to_string(r);
+
+	EXPECT_STREQ(">=1.2.3 <1.5.0 <2.0.0-0", s.c_str());
+}
+
+TEST_F(test_range_string, empty_alternative)
+{
+	const auto r = range("1.2.3 ||");
+
+	ASSERT_TRUE(r.ok());
+
+	const auto s = to_string(r);
+
+	EXPECT_STREQ(">=0.0.0 || =1.2.3", s.c_str());
+}
+
+TEST_F(test_range_string, append_to)
+{
+	for (const auto text : {"1.2.3", "^1.2.3 || ~2.0.0-rc.1", ">=1.0.0 <2.0.0 || 3.x || *",
+			 "1.2.3 - 2.3.4+build.5", "foo"}) {
+		const auto r = range(text);
+		std::string s = "x";
+
+		append_to(s, r);
+		EXPECT_EQ("x" + to_string(r), s) << text;
+		EXPECT_EQ(s.size() - 1u, formatted_size(r)) << text;
+	}
 }
 
+TEST_F(test_range_string, format_to)
+{
+	const auto r = range("^1.2.3 || 5.0.0");
+
+	std::string s;
+	format_to(std::back_inserter(s), r);
+	EXPECT_EQ("=5.0.0 || >=1.2.3 <2.0.0-0", s);
+
+	char buf[64] = {};
+	EXPECT_EQ(buf + formatted_size(r), format_to(buf, r));
+	EXPECT_STREQ(s.c_str(), buf);
+
+	std::ostringstream os;
+	os << r;
+	EXPECT_EQ(s, os.str());
+}
+}
@@ -0,0 +1,168 @@
+#include <semver/registry.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using semver::range;
+using semver::version_registry;
+using semver::semver;
+
+class test_registry : public ::testing::Test {};
+
+TEST_F(test_registry, default_constructed)
+{
+	const auto r = version_registry();
+	const auto s = r.snapshot();
+	EXPECT_TRUE(s.versions().empty());
+	EXPECT_EQ(0u, s.generation());
+	EXPECT_FALSE(s.max_satisfying(range("*")).ok());
+}
+
+TEST_F(test_registry, construction_sorts_and_removes_duplicates)
+{
+	const auto r = version_registry({semver("1.2.0"), semver("foo"), semver("1.0.0"),
+		semver("1.2.0+build"), semver("1.0.0-rc.1")});
+	const auto s = r.snapshot();
+	EXPECT_EQ((std::vector<semver> {semver("1.0.0-rc.1"), semver("1.0.0"), semver("1.2.0")}),
+		s.versions());
+	EXPECT_EQ("", s.versions()[2].build());
+}
+
+TEST_F(test_registry, publish)
+{
+	auto r = version_registry();
+	EXPECT_TRUE(r.publish(semver("1.2.0")));
+	EXPECT_TRUE(r.publish(semver("1.0.0")));
+	EXPECT_FALSE(r.publish(semver("1.0.0+other")));
+	EXPECT_FALSE(r.publish(semver("foo")));
+
+	const auto s = r.snapshot();
+	EXPECT_EQ((std::vector<semver> {semver("1.0.0"), semver("1.2.0")}), s.versions());
+	EXPECT_EQ(2u, s.generation());
+	EXPECT_TRUE(s.contains(semver("1.2.0")));
+	EXPECT_FALSE(s.contains(semver("1.1.0")));
+}
+
+TEST_F(test_registry, yank)
+{
+	auto r = version_registry({semver("1.0.0"), semver("1.1.0"), semver("1.2.0")});
+	EXPECT_TRUE(r.yank(semver("1.1.0")));
+	EXPECT_FALSE(r.yank(semver("1.1.0")));
+	EXPECT_FALSE(r.yank(semver("3.0.0")));
+
+	const auto s = r.snapshot();
+	EXPECT_EQ((std::vector<semver> {semver("1.0.0"), semver("1.2.0")}), s.versions());
+	EXPECT_EQ(1u, s.generation());
+}
+
+TEST_F(test_registry, update)
+{
+	auto r = version_registry({semver("1.0.0"), semver("1.1.0")});
+	EXPECT_EQ(4u, r.update({semver("1.2.0"), semver("1.3.0"), semver("1.0.0")},
+					  {semver("1.1.0"), semver("1.3.0"), semver("2.0.0")}));
+
+	const auto s = r.snapshot();
+	EXPECT_EQ((std::vector<semver> {semver("1.0.0"), semver("1.2.0")}), s.versions());
+	EXPECT_EQ(1u, s.generation());
+	EXPECT_EQ(0u, r.update({semver("1.0.0")}, {semver("5.0.0")}));
+}
+
+TEST_F(test_registry, snapshot_is_immutable)
+{
+	auto r = version_registry({semver("1.0.0")});
+	const auto before = r.snapshot();
+	r.publish(semver("1.1.0"));
+	r.yank(semver("1.0.0"));
+	const auto after = r.snapshot();
+
+	EXPECT_EQ((std::vector<semver> {semver("1.0.0")}), before.versions());
+	EXPECT_EQ((std::vector<semver> {semver("1.1.0")}), after.versions());
+	EXPECT_EQ(0u, before.generation());
+	EXPECT_EQ(2u, after.generation());
+}
+
+TEST_F(test_registry, max_min_satisfying)
+{
+	const auto r = version_registry({semver("0.9.0"), semver("1.0.0"), semver("1.4.2"),
+		semver("1.5.0-rc.1"), semver("2.0.0"), semver("2.1.0")});
+	const auto s = r.snapshot();
+
+	EXPECT_EQ(semver("1.5.0-rc.1"), s.max_satisfying(range("^1.0.0")));
+	EXPECT_EQ(semver("1.0.0"), s.min_satisfying(range("^1.0.0")));
+	EXPECT_EQ(semver("2.1.0"), s.max_satisfying(range("*")));
+	EXPECT_EQ(semver("0.9.0"), s.min_satisfying(range("*")));
+	EXPECT_EQ(semver("1.4.2"), s.max_satisfying(range("1.4.2 || 0.9.0")));
+	EXPECT_FALSE(s.max_satisfying(range("^3.0.0")).ok());
+	EXPECT_FALSE(s.min_satisfying(range("<0.1.0")).ok());
+	EXPECT_FALSE(s.min_satisfying(range("foo")).ok());
+}
+
+TEST_F(test_registry, replaced_states_are_reclaimed)
+{
+	auto r = version_registry();
+	{
+		const auto s = r.snapshot();
+		r.publish(semver("1.0.0"));
+		r.publish(semver("1.1.0"));
+		EXPECT_EQ(2u, r.reclaim());
+		EXPECT_TRUE(s.versions().empty());
+	}
+	EXPECT_EQ(0u, r.reclaim());
+}
+
+TEST_F(test_registry, nested_snapshots)
+{
+	auto r = version_registry();
+	auto outer = r.snapshot();
+	r.publish(semver("1.0.0"));
+	{
+		const auto inner = r.snapshot();
+		r.publish(semver("2.0.0"));
+		EXPECT_EQ(1u, inner.versions().size());
+	}
+	EXPECT_EQ(2u, r.reclaim());
+
+	const auto moved = std::move(outer);
+	EXPECT_TRUE(moved.versions().empty());
+}
+
+TEST_F(test_registry, concurrent_readers)
+{
+	auto r = version_registry();
+	std::atomic<bool> done {false};
+	std::atomic<bool> failed {false};
+
+	std::vector<std::thread> readers;
+	for (int i = 0; i < 4; ++i) {
+		readers.emplace_back([&] {
+			std::uint64_t generation = 0u;
+			while (!done.load()) {
+				const auto s = r.snapshot();
+				const auto & v = s.versions();
+				// versions 1.0.x are published in order, some yanked again
+				const auto max = s.max_satisfying(range("^1.0.0"));
+				if ((s.generation() < generation) || !std::is_sorted(begin(v), end(v))
+					|| (!v.empty() && (max != v.back())))
+					failed = true;
+				generation = s.generation();
+			}
+		});
+	}
+
+	for (semver::number_type i = 0u; i < 2000u; ++i) {
+		r.publish(semver(1, 0, i));
+		if ((i % 3u) == 0u)
+			r.yank(semver(1, 0, i / 2u));
+	}
+	done = true;
+	for (auto & t : readers)
+		t.join();
+
+	EXPECT_FALSE(failed.load());
+	EXPECT_EQ(0u, r.reclaim());
+	EXPECT_EQ(semver(1, 0, 1999), r.snapshot().max_satisfying(range("^1.0.0")));
+}
+}
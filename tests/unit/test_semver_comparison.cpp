@@ -3,6 +3,7 @@
 
 namespace {
 
+using semver::version_tuple;
 using semver::semver;
 
 class test_semver_comparison : public ::testing::Test {};
@@ -186,5 +187,86 @@ TEST_F(test_semver_comparison, less)
 {
 	EXPECT_FALSE(semver("2.2.3") < semver("1.3.0"));
 }
+
+TEST_F(test_semver_comparison, less_numeric_identifier_not_last)
+{
+	EXPECT_TRUE(semver("1.0.0-alpha.2.x") < semver("1.0.0-alpha.11.x"));
+	EXPECT_FALSE(semver("1.0.0-alpha.11.x") < semver("1.0.0-alpha.2.x"));
+	EXPECT_TRUE(semver("1.0.0-alpha.2.x") < semver("1.0.0-alpha.beta.x"));
+}
+
+TEST_F(test_semver_comparison, tuple)
+{
+	EXPECT_TRUE(semver("1.2.3") == version_tuple(1, 2, 3));
+	EXPECT_TRUE(version_tuple(1, 2, 3) == semver("1.2.3+build"));
+	EXPECT_TRUE(semver("1.2.3-rc.1") == version_tuple(1, 2, 3, "rc.1"));
+	EXPECT_FALSE(semver("1.2.3-rc.1") == version_tuple(1, 2, 3));
+
+	EXPECT_TRUE(semver("1.2.3-rc.1") < version_tuple(1, 2, 3));
+	EXPECT_TRUE(version_tuple(1, 2, 3, "rc.1") < semver("1.2.3-rc.2"));
+	EXPECT_TRUE(version_tuple(1, 9, 0) < semver("1.10.0"));
+	EXPECT_FALSE(semver("1.2.3") < version_tuple(1, 2, 3));
+	EXPECT_FALSE(version_tuple(1, 2, 3) < semver("1.2.3"));
+
+	EXPECT_EQ(0, compare(semver("1.2.3"), version_tuple(1, 2, 3)));
+	EXPECT_EQ(-1, compare(semver("1.2.3"), version_tuple(1, 2, 4)));
+	EXPECT_EQ(+1, compare(semver("1.2.3"), version_tuple(1, 2, 3, "alpha")));
 }
 
+TEST_F(test_semver_comparison, parse_tuple)
+{
+	const auto t = ::semver::parse_tuple("1.2.3-rc.1+build.7");
+	ASSERT_TRUE(t.has_value());
+	EXPECT_EQ(1u, t->major());
+	EXPECT_EQ(2u, t->minor());
+	EXPECT_EQ(3u, t->patch());
+	EXPECT_EQ("rc.1", t->prerelease());
+	EXPECT_TRUE(semver("1.2.3-rc.1") == *t);
+	EXPECT_TRUE(semver("1.2.3-rc.2") > *t);
+
+	EXPECT_TRUE(::semver::parse_tuple("0.0.0").has_value());
+	EXPECT_FALSE(::semver::parse_tuple("").has_value());
+	EXPECT_FALSE(::semver::parse_tuple("foo").has_value());
+	EXPECT_FALSE(::semver::parse_tuple("1.2").has_value());
+	EXPECT_FALSE(::semver::parse_tuple("1.2.3-").has_value());
+	EXPECT_FALSE(::semver::parse_tuple("v1.2.3").has_value());
+}
+
+TEST_F(test_semver_comparison, tuple_operators)
+{
+	const auto v = semver("1.2.3-rc.1+build");
+	const auto lower = version_tuple(1, 2, 3, "beta");
+	const auto same = version_tuple(1, 2, 3, "rc.1");
+	const auto higher = version_tuple(1, 2, 3);
+
+	EXPECT_FALSE(v != same);
+	EXPECT_TRUE(v != lower);
+	EXPECT_FALSE(same != v);
+	EXPECT_TRUE(higher != v);
+
+	EXPECT_TRUE(v <= same);
+	EXPECT_TRUE(v <= higher);
+	EXPECT_FALSE(v <= lower);
+	EXPECT_TRUE(same <= v);
+	EXPECT_TRUE(lower <= v);
+	EXPECT_FALSE(higher <= v);
+
+	EXPECT_TRUE(v > lower);
+	EXPECT_FALSE(v > same);
+	EXPECT_FALSE(v > higher);
+	EXPECT_TRUE(higher > v);
+	EXPECT_FALSE(same > v);
+	EXPECT_FALSE(lower > v);
+
+	EXPECT_TRUE(v >= same);
+	EXPECT_TRUE(v >= lower);
+	EXPECT_FALSE(v >= higher);
+	EXPECT_TRUE(same >= v);
+	EXPECT_TRUE(higher >= v);
+	EXPECT_FALSE(lower >= v);
+
+	EXPECT_EQ(0, compare(same, v));
+	EXPECT_EQ(-1, compare(lower, v));
+	EXPECT_EQ(+1, compare(higher, v));
+}
+}
@@ -386,5 +386,21 @@ TEST_F(test_semver_parser, failing_empty_prerelease_empty_build)
 
 	EXPECT_FALSE(v.ok());
 }
-}
 
+TEST_F(test_semver_parser, failure_reasons)
+{
+	using ::semver::parse_failure;
+
+	EXPECT_EQ(parse_failure::empty, semver_parser("").failure());
+	EXPECT_EQ(parse_failure::version_core, semver_parser("1.2").failure());
+	EXPECT_EQ(parse_failure::version_core, semver_parser("1.02.3").failure());
+	EXPECT_EQ(parse_failure::version_core, semver_parser("1.2-3").failure());
+	EXPECT_EQ(parse_failure::version_core, semver_parser("a.b.c").failure());
+	EXPECT_EQ(parse_failure::prerelease, semver_parser("1.2.3-").failure());
+	EXPECT_EQ(parse_failure::prerelease, semver_parser("1.2.3-a..b+c").failure());
+	EXPECT_EQ(parse_failure::build, semver_parser("1.2.3+").failure());
+	EXPECT_EQ(parse_failure::build, semver_parser("1.2.3-a+b.").failure());
+	EXPECT_EQ(parse_failure::trailing, semver_parser("1.2.3foo").failure());
+	EXPECT_EQ(parse_failure::empty, semver_parser(" v ", true).failure());
+}
+}
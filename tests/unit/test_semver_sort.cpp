@@ -0,0 +1,169 @@
+#include <semver/sort.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+
+namespace
+{
+using semver::semver;
+
+class test_semver_sort : public ::testing::Test
+{
+protected:
+	// random versions with many equal numerical cores and prereleases
+	static std::vector<semver> random_versions(std::size_t n, semver::number_type max_number)
+	{
+		static const char * prereleases[] = {"", "", "", "0", "1", "2", "11", "alpha",
+			"alpha.1", "alpha.beta", "beta", "beta.2", "beta.11", "rc.1", "x.7.z.92",
+			"0.3.7"};
+		static const char * builds[] = {"", "", "b1", "b2", "exp.sha.5114f85"};
+
+		std::mt19937 gen(42);
+		std::uniform_int_distribution<semver::number_type> number(0u, max_number);
+		std::uniform_int_distribution<std::size_t> pre(0u, std::size(prereleases) - 1u);
+		std::uniform_int_distribution<std::size_t> build(0u, std::size(builds) - 1u);
+
+		std::vector<semver> v;
+		v.reserve(n);
+		for (std::size_t i = 0; i < n; ++i)
+			v.emplace_back(number(gen), number(gen), number(gen), prereleases[pre(gen)],
+				builds[build(gen)]);
+		return v;
+	}
+
+	static void expect_same(const std::vector<semver> & a, const std::vector<semver> & b)
+	{
+		ASSERT_EQ(a.size(), b.size());
+		for (std::size_t i = 0; i < a.size(); ++i) {
+			ASSERT_EQ(a[i], b[i]) << "index=" << i;
+			ASSERT_EQ(a[i].build(), b[i].build()) << "index=" << i;
+		}
+	}
+
+	static void expect_same_precedence(
+		const std::vector<semver> & a, const std::vector<semver> & b)
+	{
+		ASSERT_EQ(a.size(), b.size());
+		for (std::size_t i = 0; i < a.size(); ++i)
+			ASSERT_EQ(a[i], b[i]) << "index=" << i;
+	}
+};
+
+TEST_F(test_semver_sort, empty)
+{
+	std::vector<semver> v;
+
+	::semver::sort(v);
+
+	EXPECT_TRUE(v.empty());
+}
+
+TEST_F(test_semver_sort, single)
+{
+	std::vector<semver> v = {semver("1.2.3")};
+
+	::semver::sort(v);
+
+	EXPECT_EQ(semver("1.2.3"), v[0]);
+}
+
+TEST_F(test_semver_sort, semver_org_example)
+{
+	std::vector<semver> v = {semver("1.0.0"), semver("1.0.0-rc.1"), semver("1.0.0-beta.11"),
+		semver("1.0.0-beta.2"), semver("1.0.0-beta"), semver("1.0.0-alpha.beta"),
+		semver("1.0.0-alpha.1"), semver("1.0.0-alpha")};
+
+	::semver::sort(v);
+
+	const std::vector<semver> expected = {semver("1.0.0-alpha"), semver("1.0.0-alpha.1"),
+		semver("1.0.0-alpha.beta"), semver("1.0.0-beta"), semver("1.0.0-beta.2"),
+		semver("1.0.0-beta.11"), semver("1.0.0-rc.1"), semver("1.0.0")};
+	expect_same(expected, v);
+}
+
+TEST_F(test_semver_sort, large_numbers)
+{
+	constexpr auto max = std::numeric_limits<semver::number_type>::max();
+	std::vector<semver> v = {semver(max, 0, 0), semver(0, max, 0), semver(0, 0, max),
+		semver(1, 0, 0), semver(0, 256, 0), semver(0, 0, 256), semver(0, 0, 255), semver()};
+
+	auto expected = v;
+	std::sort(begin(expected), end(expected));
+	::semver::sort(v);
+
+	expect_same_precedence(expected, v);
+}
+
+TEST_F(test_semver_sort, differential_sort)
+{
+	for (const auto max_number : {3ul, 300ul, 100000ul}) {
+		auto v = random_versions(20000, max_number);
+		auto expected = v;
+
+		std::sort(begin(expected), end(expected));
+		::semver::sort(v);
+
+		expect_same_precedence(expected, v);
+	}
+}
+
+TEST_F(test_semver_sort, differential_stable_sort)
+{
+	for (const auto max_number : {3ul, 300ul, 100000ul}) {
+		auto v = random_versions(20000, max_number);
+		auto expected = v;
+
+		std::stable_sort(begin(expected), end(expected));
+		::semver::stable_sort(v);
+
+		expect_same(expected, v);
+	}
+}
+
+TEST_F(test_semver_sort, differential_stable_sort_parallel)
+{
+	for (const auto max_number : {3ul, 100000ul}) {
+		auto v = random_versions(200000, max_number);
+		auto expected = v;
+
+		std::stable_sort(begin(expected), end(expected));
+		::semver::stable_sort(v, ::semver::execution::parallel);
+
+		expect_same(expected, v);
+	}
+}
+
+TEST_F(test_semver_sort, differential_sort_parallel)
+{
+	auto v = random_versions(200000, 300);
+	auto expected = v;
+
+	std::sort(begin(expected), end(expected));
+	::semver::sort(v, ::semver::execution::parallel);
+
+	expect_same_precedence(expected, v);
+}
+
+TEST_F(test_semver_sort, sub_range)
+{
+	std::vector<semver> v
+		= {semver("3.0.0"), semver("2.0.0"), semver("1.0.0"), semver("0.1.0")};
+
+	::semver::sort(v.begin() + 1, v.end());
+
+	expect_same(
+		{semver("3.0.0"), semver("0.1.0"), semver("1.0.0"), semver("2.0.0")}, v);
+}
+
+TEST_F(test_semver_sort, unique)
+{
+	std::vector<semver> v = {semver("1.0.0-alpha"), semver("1.0.0+b1"), semver("1.0.0+b2"),
+		semver("1.0.0-alpha"), semver("2.0.0"), semver("2.0.0")};
+
+	::semver::stable_sort(v);
+	::semver::unique(v);
+
+	expect_same({semver("1.0.0-alpha"), semver("1.0.0+b1"), semver("2.0.0")}, v);
+}
+}
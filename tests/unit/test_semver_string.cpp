@@ -1,5 +1,9 @@
 #include <semver/semver.hpp>
 #include <gtest/gtest.h>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
 
 namespace {
 
@@ -40,5 +44,49 @@ TEST_F(test_semver_string, strings)
 	EXPECT_SEMVER_STRING("1.0.0-0.3.7");
 	EXPECT_SEMVER_STRING("1.0.0-x-y-z.-");
 }
+
+TEST_F(test_semver_string, append_to)
+{
+	for (const auto text : {"1.2.3", "0.0.0", "1.0.0-alpha.1", "1.0.0+20130313144700",
+			 "1.0.0-beta+exp.sha.5114f85", "18446744073709551615.0.4294967296-x"}) {
+		const auto v = semver(text);
+		std::string s = "x";
+
+		append_to(s, v);
+		EXPECT_EQ(std::string("x") + text, s);
+		EXPECT_EQ(s.size() - 1u, formatted_size(v));
+	}
+}
+
+TEST_F(test_semver_string, format_to)
+{
+	const auto v = semver("1.20.300-rc.1+b.7");
+	char buf[32] = {};
+
+	const auto end = format_to(buf, v);
+	EXPECT_EQ(buf + formatted_size(v), end);
+	EXPECT_STREQ("1.20.300-rc.1+b.7", buf);
+
+	std::string s;
+	format_to(std::back_inserter(s), v);
+	format_to(std::back_inserter(s), semver("foo"));
+	EXPECT_EQ("1.20.300-rc.1+b.7<invalid>", s);
 }
 
+TEST_F(test_semver_string, max_core_length)
+{
+	constexpr auto max = std::numeric_limits<semver::number_type>::max();
+
+	EXPECT_EQ(semver::max_core_length, formatted_size(semver(max, max, max)));
+	EXPECT_EQ(semver::max_core_length, semver(max, max, max).str().size());
+}
+
+TEST_F(test_semver_string, stream)
+{
+	std::ostringstream os;
+	os << semver("1.2.3-rc.1") << '|' << std::setw(7) << semver("1.2.3") << '|'
+	   << semver("foo");
+
+	EXPECT_EQ("1.2.3-rc.1|  1.2.3|<invalid>", os.str());
+}
+}
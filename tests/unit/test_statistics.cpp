@@ -0,0 +1,127 @@
+#include <semver/statistics.hpp>
+#include <semver/range.hpp>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <thread>
+
+namespace
+{
+using semver::latency;
+using semver::parse_failure;
+using semver::range;
+using semver::statistics_snapshot;
+using semver::semver;
+
+class test_statistics : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		if (!::semver::statistics_enabled())
+			GTEST_SKIP() << "library built without ENABLE_STATISTICS";
+		::semver::reset_statistics();
+	}
+
+	void TearDown() override { ::semver::set_latency_sampling(64u); }
+};
+
+TEST_F(test_statistics, versions_parsed)
+{
+	semver("1.2.3");
+	semver("1.2.3-rc.1+b");
+	semver("");
+	semver("1.2");
+	semver("1.2.3-");
+	semver("1.2.3+");
+	semver("1.2.3foo");
+	semver("1.2.4foo");
+
+	const auto s = statistics_snapshot();
+	EXPECT_EQ(2u, s.versions_parsed);
+	EXPECT_EQ(1u, s.failures(parse_failure::empty));
+	EXPECT_EQ(1u, s.failures(parse_failure::version_core));
+	EXPECT_EQ(1u, s.failures(parse_failure::prerelease));
+	EXPECT_EQ(1u, s.failures(parse_failure::build));
+	EXPECT_EQ(2u, s.failures(parse_failure::trailing));
+}
+
+TEST_F(test_statistics, ranges_parsed)
+{
+	range("^1.2.3");
+	range("foo");
+	range("1.x || 2.x", {1024u, 1u, 1024u});
+
+	const auto s = statistics_snapshot();
+	EXPECT_EQ(1u, s.ranges_parsed);
+	EXPECT_EQ(1u, s.failures(parse_failure::range_syntax));
+	EXPECT_EQ(1u, s.failures(parse_failure::range_limit));
+}
+
+TEST_F(test_statistics, nodes_visited)
+{
+	const auto r = range("1.2.3 || >=2.0.0 <3.0.0");
+	const auto v = semver("2.5.0");
+	const auto outside = semver("4.0.0");
+	::semver::reset_statistics();
+
+	EXPECT_TRUE(r.satisfies(v)); // `=1.2.3`, `and`, `>=2.0.0`, `<3.0.0`
+	EXPECT_FALSE(r.satisfies(outside)); // rejected by the bounds
+
+	const auto s = statistics_snapshot();
+	EXPECT_EQ(2u, s.satisfies_calls);
+	EXPECT_EQ(4u, s.nodes_visited);
+}
+
+TEST_F(test_statistics, prerelease_comparisons)
+{
+	const auto a = semver("1.2.3-alpha");
+	const auto b = semver("1.2.3-beta");
+	const auto c = semver("1.2.4");
+	::semver::reset_statistics();
+
+	EXPECT_TRUE(a < b);
+	EXPECT_TRUE(b < c);
+	EXPECT_FALSE(c < a);
+
+	const auto s = statistics_snapshot();
+	EXPECT_EQ(3u, s.comparisons);
+	EXPECT_EQ(1u, s.prerelease_comparisons);
+}
+
+TEST_F(test_statistics, latencies_sampled)
+{
+	::semver::set_latency_sampling(1u);
+	for (int i = 0; i < 10; ++i)
+		semver("1.2.3");
+	::semver::set_latency_sampling(0u);
+	for (int i = 0; i < 10; ++i)
+		semver("1.2.3");
+
+	const auto s = statistics_snapshot();
+	const auto & h = s.latencies_of(latency::version_parse);
+	EXPECT_EQ(20u, s.versions_parsed);
+	EXPECT_EQ(10u, h.samples);
+	EXPECT_EQ(h.samples, std::accumulate(begin(h.buckets), end(h.buckets), std::uint64_t {0u}));
+	EXPECT_EQ(0u, s.latencies_of(latency::satisfies).samples);
+}
+
+TEST_F(test_statistics, threads_aggregated)
+{
+	std::thread t([] {
+		for (int i = 0; i < 100; ++i)
+			semver("1.2.3");
+	});
+	t.join();
+	semver("1.2.3");
+
+	EXPECT_EQ(101u, statistics_snapshot().versions_parsed);
+}
+
+TEST_F(test_statistics, reset)
+{
+	semver("1.2.3");
+	::semver::reset_statistics();
+
+	EXPECT_EQ(0u, statistics_snapshot().versions_parsed);
+}
+}
@@ -0,0 +1,147 @@
+#include <semver/tracker.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+using semver::max_satisfying_tracker;
+using semver::range;
+using semver::resolution_change;
+using semver::semver;
+
+class test_tracker : public ::testing::Test {};
+
+TEST_F(test_tracker, subscribe_resolves_immediately)
+{
+	auto t = max_satisfying_tracker();
+	EXPECT_TRUE(t.publish(semver("1.2.0")).empty());
+	EXPECT_TRUE(t.publish(semver("1.5.0")).empty());
+	EXPECT_TRUE(t.publish(semver("2.0.0")).empty());
+
+	const auto a = t.subscribe(range("^1.0.0"));
+	const auto b = t.subscribe(range("~1.2.0"));
+	const auto c = t.subscribe(range("^3.0.0"));
+	const auto d = t.subscribe(range("foo"));
+	EXPECT_EQ(semver("1.5.0"), t.best(a));
+	EXPECT_EQ(semver("1.2.0"), t.best(b));
+	EXPECT_FALSE(t.best(c).ok());
+	EXPECT_FALSE(t.best(d).ok());
+}
+
+TEST_F(test_tracker, publish_reports_changes)
+{
+	auto t = max_satisfying_tracker();
+	const auto a = t.subscribe(range("^1.0.0"));
+	const auto b = t.subscribe(range(">=1.2.0"));
+	const auto c = t.subscribe(range("^2.0.0"));
+
+	auto changes = t.publish(semver("1.2.0"));
+	ASSERT_EQ(2u, changes.size());
+	for (const auto & ch : changes) {
+		EXPECT_TRUE((ch.id == a) || (ch.id == b));
+		EXPECT_FALSE(ch.old_best.ok());
+		EXPECT_EQ(semver("1.2.0"), ch.new_best);
+	}
+
+	changes = t.publish(semver("1.1.0"));
+	EXPECT_TRUE(changes.empty());
+
+	changes = t.publish(semver("2.1.0"));
+	ASSERT_EQ(2u, changes.size());
+	EXPECT_EQ(semver("1.2.0"), t.best(a));
+	EXPECT_EQ(semver("2.1.0"), t.best(b));
+	EXPECT_EQ(semver("2.1.0"), t.best(c));
+
+	EXPECT_TRUE(t.publish(semver("2.1.0+build")).empty());
+	EXPECT_TRUE(t.publish(semver("foo")).empty());
+	EXPECT_EQ(3u, t.versions().size());
+}
+
+TEST_F(test_tracker, yank_reports_changes)
+{
+	auto t = max_satisfying_tracker();
+	for (const auto * v : {"1.0.0", "1.1.0", "1.2.0", "2.0.0"})
+		t.publish(semver(v));
+	const auto a = t.subscribe(range("^1.0.0"));
+	const auto b = t.subscribe(range("~1.2.0"));
+	const auto c = t.subscribe(range("*"));
+
+	auto changes = t.yank(semver("1.2.0"));
+	ASSERT_EQ(2u, changes.size());
+	for (const auto & ch : changes) {
+		EXPECT_EQ(semver("1.2.0"), ch.old_best);
+		if (ch.id == a) {
+			EXPECT_EQ(semver("1.1.0"), ch.new_best);
+		} else {
+			EXPECT_EQ(b, ch.id);
+			EXPECT_FALSE(ch.new_best.ok());
+		}
+	}
+	EXPECT_EQ(semver("2.0.0"), t.best(c));
+
+	EXPECT_TRUE(t.yank(semver("1.0.0")).empty());
+	EXPECT_TRUE(t.yank(semver("5.0.0")).empty());
+	EXPECT_EQ(semver("1.1.0"), t.best(a));
+}
+
+TEST_F(test_tracker, unsubscribe)
+{
+	auto t = max_satisfying_tracker();
+	const auto a = t.subscribe(range("^1.0.0"));
+	const auto b = t.subscribe(range("*"));
+	t.publish(semver("1.0.0"));
+	t.unsubscribe(a);
+	t.unsubscribe(b);
+	t.unsubscribe(b);
+
+	EXPECT_TRUE(t.publish(semver("1.1.0")).empty());
+	EXPECT_TRUE(t.yank(semver("1.0.0")).empty());
+	EXPECT_FALSE(t.best(a).ok());
+}
+
+TEST_F(test_tracker, same_as_max_satisfying)
+{
+	std::mt19937 gen(7u);
+	auto number = std::uniform_int_distribution<unsigned long>(0u, 5u);
+	const auto random_version = [&] {
+		return semver(number(gen), number(gen), number(gen), (number(gen) == 0u) ? "rc.1" : "");
+	};
+
+	auto t = max_satisfying_tracker();
+	std::vector<range> ranges;
+	std::vector<std::size_t> ids;
+	const char * ops[] = {"^", "~", ">=", "<", "", "<="};
+	for (int i = 0; i < 60; ++i) {
+		auto s = std::string(ops[number(gen)]) + random_version().str();
+		if (i % 3 == 0)
+			s += " || " + std::string(ops[number(gen)]) + random_version().str();
+		if (i % 5 == 0)
+			s = ">=" + random_version().str() + " <" + random_version().str();
+		ranges.push_back(range(s));
+		ASSERT_TRUE(ranges.back().ok()) << s;
+		ids.push_back(t.subscribe(range(s)));
+	}
+
+	std::vector<semver> best(ranges.size());
+	for (int i = 0; i < 500; ++i) {
+		const auto v = random_version();
+		const auto changes = (number(gen) < 2u) ? t.yank(v) : t.publish(v);
+
+		for (std::size_t k = 0u; k < ranges.size(); ++k) {
+			const auto expected = ranges[k].max_satisfying(t.versions());
+			ASSERT_EQ(expected.str(), t.best(ids[k]).str()) << ranges[k] << " " << i;
+		}
+
+		// exactly the changed ranges are reported
+		auto previous = best;
+		for (const auto & ch : changes) {
+			EXPECT_EQ(previous[ch.id].str(), ch.old_best.str());
+			best[ch.id] = ch.new_best;
+		}
+		for (std::size_t k = 0u; k < ranges.size(); ++k)
+			EXPECT_EQ(best[k].str(), t.best(ids[k]).str());
+	}
+}
+}
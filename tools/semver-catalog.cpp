@@ -0,0 +1,143 @@
+// semver-catalog: builds and queries version catalogs.
+//
+// Usage: semver-catalog build listing catalog
+//        semver-catalog query [-m max|min|all] catalog package range
+//
+//   build : converts a listing into a catalog file. The listing contains one version
+//           per line, either `package version` (separated by whitespace) or
+//           `package@version`. A listing of `-` is read from stdin. Invalid lines
+//           are reported on stderr and skipped.
+//   query : prints the highest (default), the lowest or all versions of the package
+//           satisfying the range, read from the memory mapped catalog.
+//
+// Exit code: 0 on success (at least one version satisfied the range), 1 if no version
+// satisfied the range, 2 for usage errors, 3 for invalid ranges and 4 for I/O errors.
+
+#include <semver/catalog.hpp>
+#include <cctype>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace
+{
+std::string_view trim(std::string_view s)
+{
+	while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+		s.remove_prefix(1u);
+	while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+		s.remove_suffix(1u);
+	return s;
+}
+
+// Splits a line of a listing into package and version.
+bool split_line(std::string_view line, std::string_view & package, std::string_view & version)
+{
+	line = trim(line);
+	auto pos = line.find_first_of(" \t");
+	if (pos == std::string_view::npos) {
+		// the package may start with `@`, e.g. `@scope/name@1.2.3`
+		pos = line.rfind('@');
+		if ((pos == std::string_view::npos) || (pos == 0u))
+			return false;
+	}
+	package = trim(line.substr(0u, pos));
+	version = trim(line.substr(pos + 1u));
+	return !package.empty() && !version.empty();
+}
+
+int build(const char * listing, const char * output)
+{
+	std::FILE * in = (std::string_view(listing) == "-") ? stdin : std::fopen(listing, "rb");
+	if (!in)
+		return 4;
+
+	semver::catalog_builder builder;
+	std::string line;
+	std::size_t number = 0u;
+	char buf[4096];
+	bool eof = false;
+	while (!eof) {
+		eof = std::fgets(buf, sizeof(buf), in) == nullptr;
+		if (!eof)
+			line += buf;
+		if (line.empty() || (!eof && (line.back() != '\n')))
+			continue;
+
+		++number;
+		std::string_view package;
+		std::string_view version;
+		if (!trim(line).empty()) {
+			if (!split_line(line, package, version)
+				|| !builder.add(package, semver::semver(std::string(version))))
+				std::fprintf(stderr, "%s:%zu: invalid line\n", listing, number);
+		}
+		line.clear();
+	}
+	const bool input_ok = !std::ferror(in);
+	if (in != stdin)
+		std::fclose(in);
+	if (!input_ok)
+		return 4;
+
+	return builder.write(output) ? 0 : 4;
+}
+
+int query(int argc, char ** argv)
+{
+	std::string_view mode = "max";
+	int i = 2;
+	if ((argc > i) && (std::string_view(argv[i]) == "-m")) {
+		if (argc <= i + 1)
+			return 2;
+		mode = argv[i + 1];
+		i += 2;
+	}
+	if ((argc != i + 3) || ((mode != "max") && (mode != "min") && (mode != "all")))
+		return 2;
+
+	const auto r = semver::range(argv[i + 2]);
+	if (!r.ok())
+		return 3;
+
+	const auto file = semver::catalog_file(argv[i]);
+	if (!file.ok())
+		return 4;
+
+	const auto versions = file.get().versions(argv[i + 1]);
+	bool found = false;
+	const auto print = [&found](const semver::semver_view & v) {
+		const auto s = v.to_semver().str();
+		std::printf("%s\n", s.c_str());
+		found = true;
+	};
+
+	if (mode == "all") {
+		for (const auto & v : versions.satisfying(r))
+			print(v);
+	} else {
+		const auto v = (mode == "max") ? versions.max_satisfying(r) : versions.min_satisfying(r);
+		if (v.ok())
+			print(v);
+	}
+	return found ? 0 : 1;
+}
+}
+
+int main(int argc, char ** argv)
+{
+	const std::string_view command = (argc > 1) ? argv[1] : "";
+	int rc = 2;
+	if ((command == "build") && (argc == 4))
+		rc = build(argv[2], argv[3]);
+	else if (command == "query")
+		rc = query(argc, argv);
+
+	if (rc == 2) {
+		std::fprintf(stderr,
+			"usage: %s build listing catalog\n"
+			"       %s query [-m max|min|all] catalog package range\n",
+			argv[0], argv[0]);
+	}
+	return rc;
+}
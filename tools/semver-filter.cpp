@@ -0,0 +1,422 @@
+// semver-filter: checks a stream of versions, one per line, against ranges.
+//
+// Usage: semver-filter [options] range...
+//
+//   -f file   read versions from file (memory mapped if possible), default is stdin
+//   -m mode   match   : print versions satisfying all ranges (default)
+//             verdict : print every line followed by `yes`, `no` or `invalid`
+//             max     : print the highest version satisfying all ranges
+//             min     : print the lowest version satisfying all ranges
+//   -j n      number of worker threads, default is the number of cores
+//
+// A version must satisfy all ranges. The input is processed in chunks: one reader
+// splits the input at line boundaries, workers parse and evaluate the chunks in
+// parallel, and the writer outputs the results in input order. The number of
+// chunks in flight is limited, memory usage is therefore bounded, independent
+// of the input size. Lines longer than 64 KiB are invalid, only their beginning
+// is kept.
+//
+// Exit code: 0 if at least one version satisfied the ranges, 1 if none did,
+// 2 for usage errors, 3 for invalid ranges and 4 for input errors.
+
+#include <semver/range.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define SEMVER_FILTER_MMAP
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace
+{
+enum class mode { match, verdict, max, min };
+
+struct options {
+	mode m = mode::match;
+	std::string file;
+	unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<semver::range> ranges;
+};
+
+// A chunk of complete lines, either a view into mapped memory or owning the text.
+struct chunk {
+	std::string storage;
+	std::string_view text;
+};
+
+struct result {
+	std::string output;
+	std::optional<semver::semver> best;
+	bool matched = false;
+};
+
+template <typename T> class bounded_queue
+{
+public:
+	explicit bounded_queue(std::size_t capacity)
+		: capacity_(capacity)
+	{
+	}
+
+	void push(T t)
+	{
+		std::unique_lock<std::mutex> lock(mtx_);
+		not_full_.wait(lock, [this] { return items_.size() < capacity_; });
+		items_.push_back(std::move(t));
+		not_empty_.notify_one();
+	}
+
+	// returns false if the queue is closed and drained
+	bool pop(T & t)
+	{
+		std::unique_lock<std::mutex> lock(mtx_);
+		not_empty_.wait(lock, [this] { return !items_.empty() || closed_; });
+		if (items_.empty())
+			return false;
+		t = std::move(items_.front());
+		items_.pop_front();
+		not_full_.notify_one();
+		return true;
+	}
+
+	void close()
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		closed_ = true;
+		not_empty_.notify_all();
+	}
+
+private:
+	std::size_t capacity_;
+	std::deque<T> items_;
+	bool closed_ = false;
+	std::mutex mtx_;
+	std::condition_variable not_full_;
+	std::condition_variable not_empty_;
+};
+
+struct job {
+	chunk data;
+	std::promise<result> promise;
+};
+
+constexpr std::size_t chunk_size = 1024u * 1024u;
+constexpr std::size_t max_line_size = 64u * 1024u;
+
+// Lines are checked as text, without constructing versions.
+bool satisfies_all(const options & opt, std::string_view line)
+{
+	return std::all_of(begin(opt.ranges), end(opt.ranges),
+		[line](const auto & r) { return r.satisfies(line); });
+}
+
+bool is_better(mode m, const semver::semver & v, const std::optional<semver::semver> & best)
+{
+	if (!best)
+		return true;
+	return (m == mode::max) ? (*best < v) : (v < *best);
+}
+
+bool is_better(mode m, const semver::version_tuple & v, const semver::semver & best)
+{
+	return (m == mode::max) ? (best < v) : (v < best);
+}
+
+result process(const options & opt, std::string_view text)
+{
+	result res;
+	while (!text.empty()) {
+		const auto eol = text.find('\n');
+		auto line = text.substr(0, eol);
+		text.remove_prefix((eol == std::string_view::npos) ? text.size() : eol + 1);
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+
+		if (line.size() > max_line_size) {
+			if (opt.m == mode::verdict) {
+				res.output.append(line.data(), max_line_size);
+				res.output += "\tinvalid\n";
+			}
+			continue;
+		}
+
+		const bool ok = satisfies_all(opt, line);
+		res.matched |= ok;
+
+		switch (opt.m) {
+			case mode::match:
+				if (ok) {
+					res.output.append(line.data(), line.size());
+					res.output += '\n';
+				}
+				break;
+			case mode::verdict:
+				res.output.append(line.data(), line.size());
+				if (ok)
+					res.output += "\tyes\n";
+				else
+					res.output += semver::parse_tuple(line) ? "\tno\n" : "\tinvalid\n";
+				break;
+			case mode::max:
+			case mode::min:
+				// candidates are compared as text, only the best ones are constructed,
+				// satisfying lines are valid versions
+				if (ok
+					&& (!res.best || is_better(opt.m, *semver::parse_tuple(line), *res.best)))
+					res.best = semver::semver(std::string(line));
+				break;
+		}
+	}
+	return res;
+}
+
+// Splits the input into chunks of complete lines and hands them to `emit`. Of lines
+// longer than `max_line_size` only the beginning is kept, the rest is skipped.
+template <typename Emit> bool read_stream(std::FILE * f, Emit emit)
+{
+	std::string carry;
+	bool skip = false;
+	for (;;) {
+		std::string buf = std::move(carry);
+		carry.clear();
+		const auto offset = buf.size();
+		buf.resize(offset + chunk_size);
+		const auto n = std::fread(&buf[offset], 1u, chunk_size, f);
+		buf.resize(offset + n);
+		if (n == 0u) {
+			if (!buf.empty())
+				emit(chunk {std::move(buf), {}});
+			return !std::ferror(f);
+		}
+		if (skip) {
+			const auto eol = buf.find('\n');
+			if (eol == std::string::npos)
+				continue;
+			buf.erase(0u, eol + 1u);
+			skip = false;
+		}
+		const auto eol = buf.rfind('\n');
+		if (eol == std::string::npos) {
+			carry = std::move(buf);
+		} else {
+			carry.assign(buf, eol + 1u, std::string::npos);
+			buf.resize(eol + 1u);
+			emit(chunk {std::move(buf), {}});
+		}
+		if (carry.size() > max_line_size) {
+			// one character more than allowed marks the line as too long
+			carry.resize(max_line_size + 1u);
+			carry += '\n';
+			emit(chunk {std::move(carry), {}});
+			carry.clear();
+			skip = true;
+		}
+	}
+}
+
+#if defined(SEMVER_FILTER_MMAP)
+class mapped_file
+{
+public:
+	explicit mapped_file(const std::string & path)
+	{
+		fd_ = ::open(path.c_str(), O_RDONLY);
+		if (fd_ < 0)
+			return;
+		struct stat st;
+		if (::fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode))
+			return;
+		size_ = static_cast<std::size_t>(st.st_size);
+		if (size_ == 0u) {
+			good_ = true;
+			return;
+		}
+		void * p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+		if (p == MAP_FAILED)
+			return;
+		::madvise(p, size_, MADV_SEQUENTIAL);
+		data_ = static_cast<const char *>(p);
+		good_ = true;
+	}
+
+	~mapped_file()
+	{
+		if (data_)
+			::munmap(const_cast<char *>(data_), size_);
+		if (fd_ >= 0)
+			::close(fd_);
+	}
+
+	mapped_file(const mapped_file &) = delete;
+	mapped_file & operator=(const mapped_file &) = delete;
+
+	bool ok() const noexcept { return good_; }
+	std::string_view data() const noexcept { return {data_, size_}; }
+
+private:
+	int fd_ = -1;
+	const char * data_ = nullptr;
+	std::size_t size_ = 0u;
+	bool good_ = false;
+};
+
+template <typename Emit> void read_mapped(std::string_view data, Emit emit)
+{
+	while (!data.empty()) {
+		auto n = std::min(chunk_size, data.size());
+		if (n < data.size()) {
+			const auto eol = data.substr(n).find('\n');
+			n = (eol == std::string_view::npos) ? data.size() : n + eol + 1u;
+		}
+		emit(chunk {{}, data.substr(0, n)});
+		data.remove_prefix(n);
+	}
+}
+#endif
+
+bool parse_options(int argc, char ** argv, options & opt)
+{
+	int i = 1;
+	for (; i < argc; ++i) {
+		const std::string_view a = argv[i];
+		if (a.size() < 2u || a[0] != '-')
+			break;
+		if (i + 1 >= argc)
+			return false;
+		const std::string_view value = argv[++i];
+		if (a == "-f") {
+			opt.file = value;
+		} else if (a == "-m") {
+			if (value == "match")
+				opt.m = mode::match;
+			else if (value == "verdict")
+				opt.m = mode::verdict;
+			else if (value == "max")
+				opt.m = mode::max;
+			else if (value == "min")
+				opt.m = mode::min;
+			else
+				return false;
+		} else if (a == "-j") {
+			opt.threads = static_cast<unsigned int>(std::max(1, std::atoi(value.data())));
+		} else {
+			return false;
+		}
+	}
+	for (; i < argc; ++i)
+		opt.ranges.emplace_back(argv[i]);
+	return !opt.ranges.empty();
+}
+}
+
+int main(int argc, char ** argv)
+{
+	options opt;
+	if (!parse_options(argc, argv, opt)) {
+		std::fprintf(stderr,
+			"usage: %s [-f file] [-m match|verdict|max|min] [-j threads] range...\n", argv[0]);
+		return 2;
+	}
+	if (std::any_of(begin(opt.ranges), end(opt.ranges), [](const auto & r) { return !r.ok(); }))
+		return 3;
+
+	std::FILE * in = stdin;
+#if defined(SEMVER_FILTER_MMAP)
+	// pipes, devices and files which cannot be mapped are read as stream
+	std::unique_ptr<mapped_file> mapped;
+	if (!opt.file.empty()) {
+		mapped = std::make_unique<mapped_file>(opt.file);
+		if (!mapped->ok())
+			mapped.reset();
+	}
+	const bool stream = !mapped;
+#else
+	const bool stream = true;
+#endif
+	if (!opt.file.empty() && stream) {
+		in = std::fopen(opt.file.c_str(), "rb");
+		if (!in)
+			return 4;
+	}
+
+	bounded_queue<std::shared_ptr<job>> work(opt.threads * 2u);
+	bounded_queue<std::future<result>> pending(opt.threads * 2u + 2u);
+
+	std::vector<std::thread> workers;
+	for (unsigned int i = 0; i < opt.threads; ++i) {
+		workers.emplace_back([&opt, &work] {
+			std::shared_ptr<job> j;
+			while (work.pop(j)) {
+				const auto text = j->data.storage.empty() ? j->data.text
+														  : std::string_view(j->data.storage);
+				j->promise.set_value(process(opt, text));
+			}
+		});
+	}
+
+	bool matched = false;
+	std::optional<semver::semver> best;
+	std::thread writer([&] {
+		std::future<result> f;
+		while (pending.pop(f)) {
+			auto r = f.get();
+			matched |= r.matched;
+			if (!r.output.empty())
+				std::fwrite(r.output.data(), 1u, r.output.size(), stdout);
+			if (r.best && is_better(opt.m, *r.best, best))
+				best = std::move(r.best);
+		}
+	});
+
+	const auto emit = [&](chunk c) {
+		auto j = std::make_shared<job>();
+		j->data = std::move(c);
+		pending.push(j->promise.get_future());
+		work.push(std::move(j));
+	};
+
+	bool input_ok = true;
+#if defined(SEMVER_FILTER_MMAP)
+	if (mapped)
+		read_mapped(mapped->data(), emit);
+	else
+		input_ok = read_stream(in, emit);
+#else
+	input_ok = read_stream(in, emit);
+#endif
+
+	work.close();
+	for (auto & w : workers)
+		w.join();
+	pending.close();
+	writer.join();
+
+	if (in != stdin)
+		std::fclose(in);
+
+	if (best) {
+		const auto s = best->str();
+		std::printf("%s\n", s.c_str());
+	}
+	std::fflush(stdout);
+
+	if (!input_ok)
+		return 4;
+	return matched ? 0 : 1;
+}
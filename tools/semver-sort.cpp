@@ -0,0 +1,553 @@
+// semver-sort: sorts lines of versions by precedence, also inputs larger than memory.
+//
+// Usage: semver-sort [options]
+//
+//   -f file   read lines from file, default is stdin
+//   -o file   write sorted lines to file, default is stdout
+//   -u        unique: of lines with equal package and precedence, keep only the first
+//   -S size   memory for sorting in bytes, suffixes K, M and G are accepted, default 256M
+//   -T dir    directory for temporary files, default is the system's one
+//   -j n      number of threads sorting runs, default is the number of cores
+//
+// Lines are either a version or `package@version` (the last `@`, not at the beginning
+// of the line, separates them). Lines are ordered by package (bytewise) first, then by
+// precedence of the version. Lines of equal order keep their input order. Lines with
+// invalid versions are reported on stderr and skipped.
+//
+// External merge sort: the input is split into runs which fit into memory. Every run
+// is sorted by a precomputed key (package and order preserving version key, compared
+// bytewise) and spilled into a temporary file. Runs are sorted by multiple threads
+// while the input is read. The runs are merged k-way, again by their keys.
+//
+// Exit code: 0 on success, 2 for usage errors and 4 for I/O errors.
+
+#include <semver/key.hpp>
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define SEMVER_SORT_MKSTEMP
+	#include <unistd.h>
+#endif
+
+namespace
+{
+struct options {
+	std::string input;
+	std::string output;
+	std::string tmpdir;
+	bool unique = false;
+	std::size_t memory = 256u * 1024u * 1024u;
+	unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+};
+
+// maximum number of runs merged at once
+constexpr std::size_t merge_fan_in = 64u;
+
+constexpr std::size_t io_buffer_size = 1024u * 1024u;
+
+// Lines of a run and their keys, stored contiguously.
+struct run {
+	struct record {
+		std::size_t key_offset;
+		std::size_t key_size;
+		std::size_t line_offset;
+		std::size_t line_size;
+	};
+
+	std::string lines;
+	std::string keys;
+	std::vector<record> records;
+
+	std::string_view key(const record & r) const noexcept
+	{
+		return std::string_view(keys).substr(r.key_offset, r.key_size);
+	}
+
+	std::string_view line(const record & r) const noexcept
+	{
+		return std::string_view(lines).substr(r.line_offset, r.line_size);
+	}
+};
+
+using file_ptr = std::unique_ptr<std::FILE, int (*)(std::FILE *)>;
+
+file_ptr temporary_file(const options & opt)
+{
+#if defined(SEMVER_SORT_MKSTEMP)
+	if (!opt.tmpdir.empty()) {
+		std::string path = opt.tmpdir + "/semver-sort-XXXXXX";
+		const int fd = ::mkstemp(path.data());
+		if (fd < 0)
+			return {nullptr, std::fclose};
+		::unlink(path.c_str()); // removed as soon as it is closed
+		return {::fdopen(fd, "w+b"), std::fclose};
+	}
+#else
+	(void)opt;
+#endif
+	return {std::tmpfile(), std::fclose};
+}
+
+std::string_view trim(std::string_view s)
+{
+	while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+		s.remove_prefix(1u);
+	while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+		s.remove_suffix(1u);
+	return s;
+}
+
+// The key of a line is the package, a terminating zero byte (less than any character,
+// shorter packages sort first) and the key of the version.
+bool append_key(std::string_view line, std::string & key)
+{
+	std::string_view package;
+	std::string_view version = line;
+	const auto at = line.rfind('@');
+	if ((at != std::string_view::npos) && (at > 0u)) {
+		package = line.substr(0u, at);
+		version = line.substr(at + 1u);
+	}
+	const auto v = semver::semver(std::string(trim(version)));
+	if (!v.ok())
+		return false;
+	key.append(package.data(), package.size());
+	key += '\0';
+	return semver::encode_key(v, key);
+}
+
+void sort_run(run & r, bool unique)
+{
+	std::stable_sort(begin(r.records), end(r.records),
+		[&r](const auto & a, const auto & b) { return r.key(a) < r.key(b); });
+	if (unique) {
+		r.records.erase(std::unique(begin(r.records), end(r.records),
+							[&r](const auto & a, const auto & b) { return r.key(a) == r.key(b); }),
+			end(r.records));
+	}
+}
+
+// A spilled run: records of key and line, each preceded by its length (32 bit,
+// little endian). Runs are written and read with large buffers, in sequence.
+class run_writer
+{
+public:
+	explicit run_writer(std::FILE * f)
+		: file_(f)
+	{
+		buffer_.reserve(io_buffer_size);
+	}
+
+	void write(std::string_view key, std::string_view line)
+	{
+		write_u32(key.size());
+		buffer_.append(key.data(), key.size());
+		write_u32(line.size());
+		buffer_.append(line.data(), line.size());
+		if (buffer_.size() >= io_buffer_size)
+			flush();
+	}
+
+	// returns false on errors
+	bool flush()
+	{
+		good_ = good_ && (std::fwrite(buffer_.data(), 1u, buffer_.size(), file_) == buffer_.size());
+		buffer_.clear();
+		return good_ && (std::fflush(file_) == 0);
+	}
+
+private:
+	std::FILE * file_;
+	std::string buffer_;
+	bool good_ = true;
+
+	void write_u32(std::size_t n)
+	{
+		for (std::size_t i = 0u; i < 4u; ++i)
+			buffer_ += static_cast<char>((n >> (8u * i)) & 0xffu);
+	}
+};
+
+class run_reader
+{
+public:
+	explicit run_reader(file_ptr f)
+		: file_(std::move(f))
+		, buffer_(io_buffer_size)
+	{
+		std::rewind(file_.get());
+	}
+
+	// returns false at the end of the run or on errors
+	bool next()
+	{
+		std::size_t n = 0u;
+		if (!read_u32(n) || !read(key_, n) || !read_u32(n))
+			return false;
+		return read(line_, n);
+	}
+
+	bool error() const { return std::ferror(file_.get()) != 0; }
+
+	const std::string & key() const noexcept { return key_; }
+	const std::string & line() const noexcept { return line_; }
+
+private:
+	file_ptr file_;
+	std::vector<char> buffer_;
+	std::size_t pos_ = 0u;
+	std::size_t end_ = 0u;
+	std::string key_;
+	std::string line_;
+
+	bool read(std::string & s, std::size_t n)
+	{
+		s.clear();
+		while (s.size() < n) {
+			if ((pos_ == end_) && !fill())
+				return false;
+			const auto k = std::min(n - s.size(), end_ - pos_);
+			s.append(buffer_.data() + pos_, k);
+			pos_ += k;
+		}
+		return true;
+	}
+
+	bool read_u32(std::size_t & n)
+	{
+		n = 0u;
+		for (std::size_t i = 0u; i < 4u; ++i) {
+			if ((pos_ == end_) && !fill())
+				return false;
+			n |= static_cast<std::size_t>(static_cast<unsigned char>(buffer_[pos_++])) << (8u * i);
+		}
+		return true;
+	}
+
+	bool fill()
+	{
+		pos_ = 0u;
+		end_ = std::fread(buffer_.data(), 1u, buffer_.size(), file_.get());
+		return end_ > 0u;
+	}
+};
+
+// Merges the runs k-way, calls `emit(key, line)` in order. Equal keys are emitted
+// in the order of the runs, which is the input order.
+template <typename Emit> bool merge(std::vector<file_ptr> files, bool unique, Emit emit)
+{
+	std::vector<std::unique_ptr<run_reader>> readers;
+	for (auto & f : files)
+		readers.push_back(std::make_unique<run_reader>(std::move(f)));
+
+	const auto greater = [&readers](std::size_t a, std::size_t b) {
+		const auto c = readers[a]->key().compare(readers[b]->key());
+		return (c > 0) || ((c == 0) && (a > b));
+	};
+	std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(greater)> heap(greater);
+	for (std::size_t i = 0u; i < readers.size(); ++i)
+		if (readers[i]->next())
+			heap.push(i);
+
+	std::string last;
+	bool first = true;
+	while (!heap.empty()) {
+		const auto i = heap.top();
+		heap.pop();
+		auto & r = *readers[i];
+		if (!unique || first || (r.key() != last)) {
+			emit(r.key(), r.line());
+			if (unique)
+				last = r.key();
+			first = false;
+		}
+		if (r.next())
+			heap.push(i);
+	}
+	return std::none_of(begin(readers), end(readers), [](const auto & r) { return r->error(); });
+}
+
+class run_sorter
+{
+public:
+	run_sorter(const options & opt)
+		: opt_(opt)
+	{
+		for (unsigned int i = 0; i < opt_.threads; ++i)
+			workers_.emplace_back([this] { work(); });
+	}
+
+	// Sorts and spills the run in the background. Blocks if all threads are busy,
+	// the number of runs in memory is therefore bounded.
+	void push(run r)
+	{
+		std::unique_lock<std::mutex> lock(mtx_);
+		not_full_.wait(lock, [this] { return pending_.size() < opt_.threads; });
+		pending_.push_back(std::move(r));
+		not_empty_.notify_one();
+	}
+
+	// Waits for all runs to be spilled, returns them in input order.
+	std::vector<file_ptr> finish(bool & ok)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			closed_ = true;
+			not_empty_.notify_all();
+		}
+		for (auto & w : workers_)
+			w.join();
+		ok = good_;
+		std::vector<file_ptr> files;
+		for (auto & f : files_)
+			files.push_back(std::move(f));
+		return files;
+	}
+
+private:
+	const options & opt_;
+	std::vector<std::thread> workers_;
+	std::mutex mtx_;
+	std::condition_variable not_full_;
+	std::condition_variable not_empty_;
+	std::deque<run> pending_;
+	std::size_t next_index_ = 0u;
+	std::deque<file_ptr> files_;
+	bool closed_ = false;
+	bool good_ = true;
+
+	void work()
+	{
+		for (;;) {
+			run r;
+			std::size_t index = 0u;
+			{
+				std::unique_lock<std::mutex> lock(mtx_);
+				not_empty_.wait(lock, [this] { return !pending_.empty() || closed_; });
+				if (pending_.empty())
+					return;
+				r = std::move(pending_.front());
+				pending_.pop_front();
+				index = next_index_++;
+				while (files_.size() <= index)
+					files_.emplace_back(nullptr, std::fclose);
+				not_full_.notify_one();
+			}
+
+			sort_run(r, opt_.unique);
+			auto f = temporary_file(opt_);
+			bool ok = !!f;
+			if (ok) {
+				run_writer w(f.get());
+				for (const auto & rec : r.records)
+					w.write(r.key(rec), r.line(rec));
+				ok = w.flush();
+			}
+
+			std::lock_guard<std::mutex> lock(mtx_);
+			good_ = good_ && ok;
+			files_[index] = std::move(f);
+		}
+	}
+};
+
+// Reads lines, calls `add(line)` for each of them, without line endings.
+template <typename Add> bool read_lines(std::FILE * f, Add add)
+{
+	std::unique_ptr<char[]> buf(new char[io_buffer_size]);
+	std::string carry;
+	for (;;) {
+		const auto n = std::fread(buf.get(), 1u, io_buffer_size, f);
+		std::string_view data(buf.get(), n);
+		if (n == 0u) {
+			if (!carry.empty())
+				add(std::string_view(carry));
+			return !std::ferror(f);
+		}
+		for (auto eol = data.find('\n'); eol != std::string_view::npos; eol = data.find('\n')) {
+			if (carry.empty()) {
+				add(data.substr(0u, eol));
+			} else {
+				carry.append(data.data(), eol);
+				add(std::string_view(carry));
+				carry.clear();
+			}
+			data.remove_prefix(eol + 1u);
+		}
+		carry.append(data.data(), data.size());
+	}
+}
+
+bool parse_size(std::string_view s, std::size_t & n)
+{
+	char * end = nullptr;
+	const std::string str(s);
+	const auto v = std::strtoull(str.c_str(), &end, 10);
+	if ((end == str.c_str()) || (v == 0u))
+		return false;
+	std::size_t factor = 1u;
+	const std::string_view suffix(end);
+	if (suffix == "K")
+		factor = 1024u;
+	else if (suffix == "M")
+		factor = 1024u * 1024u;
+	else if (suffix == "G")
+		factor = 1024u * 1024u * 1024u;
+	else if (!suffix.empty())
+		return false;
+	n = static_cast<std::size_t>(v) * factor;
+	return true;
+}
+
+bool parse_options(int argc, char ** argv, options & opt)
+{
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view a = argv[i];
+		if (a == "-u") {
+			opt.unique = true;
+			continue;
+		}
+		if (i + 1 >= argc)
+			return false;
+		const std::string_view value = argv[++i];
+		if (a == "-f") {
+			opt.input = value;
+		} else if (a == "-o") {
+			opt.output = value;
+		} else if (a == "-T") {
+			opt.tmpdir = value;
+		} else if (a == "-S") {
+			if (!parse_size(value, opt.memory))
+				return false;
+		} else if (a == "-j") {
+			opt.threads = static_cast<unsigned int>(std::max(1, std::atoi(value.data())));
+		} else {
+			return false;
+		}
+	}
+	return true;
+}
+}
+
+int main(int argc, char ** argv)
+{
+	options opt;
+	if (!parse_options(argc, argv, opt)) {
+		std::fprintf(stderr,
+			"usage: %s [-f file] [-o file] [-u] [-S size] [-T dir] [-j threads]\n", argv[0]);
+		return 2;
+	}
+
+	// declared before the output, it must outlive it
+	std::unique_ptr<char[]> out_buffer(new char[io_buffer_size]);
+
+	file_ptr in(opt.input.empty() ? stdin : std::fopen(opt.input.c_str(), "rb"),
+		[](std::FILE * f) { return (f == stdin) ? 0 : std::fclose(f); });
+	file_ptr out(opt.output.empty() ? stdout : std::fopen(opt.output.c_str(), "wb"),
+		[](std::FILE * f) { return (f == stdout) ? std::fflush(f) : std::fclose(f); });
+	if (!in || !out)
+		return 4;
+	std::setvbuf(out.get(), out_buffer.get(), _IOFBF, io_buffer_size);
+
+	// the memory is shared by the run being read and the runs being sorted
+	const auto run_size = std::max<std::size_t>(1u, opt.memory / (2u * opt.threads + 1u));
+
+	run_sorter sorter(opt);
+	std::vector<run> in_memory; // if the input fits into one run, it is never spilled
+	run current;
+	std::size_t line_number = 0u;
+	std::size_t runs = 0u;
+	const auto flush = [&] {
+		if (current.records.empty())
+			return;
+		if (runs++ == 0u) {
+			in_memory.push_back(std::move(current));
+		} else {
+			if (!in_memory.empty()) {
+				sorter.push(std::move(in_memory.front()));
+				in_memory.clear();
+			}
+			sorter.push(std::move(current));
+		}
+		current = run {};
+	};
+
+	const bool input_ok = read_lines(in.get(), [&](std::string_view line) {
+		++line_number;
+		if (!line.empty() && (line.back() == '\r'))
+			line.remove_suffix(1u);
+		if (trim(line).empty())
+			return;
+		const auto key_offset = current.keys.size();
+		if (!append_key(line, current.keys)) {
+			current.keys.resize(key_offset);
+			std::fprintf(stderr, "%zu: invalid version: %.*s\n", line_number,
+				static_cast<int>(line.size()), line.data());
+			return;
+		}
+		current.records.push_back({key_offset, current.keys.size() - key_offset,
+			current.lines.size(), line.size()});
+		current.lines.append(line.data(), line.size());
+		if (current.lines.size() + current.keys.size()
+				+ current.records.size() * sizeof(run::record)
+			>= run_size)
+			flush();
+	});
+	flush();
+
+	bool ok = true;
+	auto files = sorter.finish(ok);
+	if (!input_ok || !ok)
+		return 4;
+
+	const auto write_line = [&out](std::string_view, std::string_view line) {
+		std::fwrite(line.data(), 1u, line.size(), out.get());
+		std::fputc('\n', out.get());
+	};
+
+	if (!in_memory.empty()) {
+		auto & r = in_memory.front();
+		sort_run(r, opt.unique);
+		for (const auto & rec : r.records)
+			write_line(r.key(rec), r.line(rec));
+	} else {
+		// merge passes until the number of runs does not exceed the fan in
+		while (files.size() > merge_fan_in) {
+			std::vector<file_ptr> merged;
+			for (std::size_t i = 0u; i < files.size(); i += merge_fan_in) {
+				std::vector<file_ptr> group;
+				for (std::size_t j = i; j < std::min(files.size(), i + merge_fan_in); ++j)
+					group.push_back(std::move(files[j]));
+				auto f = temporary_file(opt);
+				if (!f)
+					return 4;
+				run_writer w(f.get());
+				if (!merge(std::move(group), opt.unique,
+						[&w](std::string_view key, std::string_view line) { w.write(key, line); })
+					|| !w.flush())
+					return 4;
+				merged.push_back(std::move(f));
+			}
+			files = std::move(merged);
+		}
+		if (!merge(std::move(files), opt.unique, write_line))
+			return 4;
+	}
+
+	if ((std::fflush(out.get()) != 0) || std::ferror(out.get()))
+		return 4;
+	return 0;
+}